@@ -54,4 +54,86 @@ vector<T> and_convolution(const vector<T> &a, const vector<T> &b) {
 	for (int i = 0; i < n2; i++) a2[i] *= b2[i];
 	_and_moebius(a2);
 	return a2;
-}
\ No newline at end of file
+}
+
+/**
+ * @brief Zeta 変換後の値を保持するクラス。同じ列を何度も畳み込む場合や AND convolution の冪乗を求める場合に、変換を使い回せる。
+ *
+ * @tparam T 環
+ */
+template<class T>
+struct and_transform {
+	/**
+	 * @brief `a` を変換した値で初期化する。
+	 *
+	 * O(N log N)
+	 * @param a `vector`
+	 * @param n 長さ。 `a.size()` と `n` 以上の最小の 2 冪に切り上げられる。
+	 */
+	and_transform(const vector<T> &a, int n=0) {
+		int n2 = 1;
+		while (n2 < a.size() || n2 < n) n2 *= 2;
+		_v.assign(n2, 0);
+		for (int i = 0; i < a.size(); i++) _v[i] = a[i];
+		_and_zeta(_v);
+	}
+
+	/**
+	 * @brief 変換後の列の長さを返す。
+	 *
+	 * @return 長さ
+	 */
+	int size() const {
+		return _v.size();
+	}
+
+	/**
+	 * @brief 各点積を取る。これは元の列どうしの AND convolution に対応する。長さが等しい必要がある。
+	 *
+	 * O(N)
+	 * @param a 変換後の列
+	 * @return `*this`
+	 */
+	and_transform &operator*=(const and_transform &a) {
+		assert(_v.size() == a._v.size());
+		for (int i = 0; i < _v.size(); i++) _v[i] *= a._v[i];
+		return *this;
+	}
+	and_transform operator*(const and_transform &a) const { return and_transform(*this) *= a; }
+
+	/**
+	 * @brief 各点で冪乗を取る。これは元の列の AND convolution に関する `t` 乗に対応する。
+	 *
+	 * O(N log t)
+	 * @param t 非負の指数
+	 * @return 冪乗
+	 */
+	and_transform pow(long long t) const {
+		assert(t >= 0);
+		and_transform res(*this);
+		for (int i = 0; i < _v.size(); i++) {
+			T x = 1;
+			T mul = _v[i];
+			for (long long s = t; s; s >>= 1) {
+				if (s & 1) x *= mul;
+				mul *= mul;
+			}
+			res._v[i] = x;
+		}
+		return res;
+	}
+
+	/**
+	 * @brief 逆変換を行い、元の列に戻す。
+	 *
+	 * O(N log N)
+	 * @return 長さ `size()` の `vector`
+	 */
+	vector<T> inverse() const {
+		vector<T> res = _v;
+		_and_moebius(res);
+		return res;
+	}
+private:
+	vector<T> _v;
+};
\ No newline at end of file
@@ -14,6 +14,7 @@
 #include <bits/stdc++.h>
 #include "../custom_concepts.hpp"
 #include "../mint/montgomery_mint.hpp"
+#include "../mint/mint_simd.hpp"
 #include "../number_theory/primitive_root.hpp"
 using namespace std;
 
@@ -47,24 +48,22 @@ struct ntt_friendly_convolution_base {
 	 * @return `a` と `b` の畳み込みである、長さ `a.size()+b.size()-1` の `vector`
 	 */
 	vector<mint> operator()(const vector<mint> &a, const vector<mint> &b) const {
+		if (!a.empty() && !b.empty() && min(a.size(), b.size()) <= _naive_threshold) return _naive(a, b);
 		int n = a.size() + b.size() - 1;
 		int n2 = 1;
 		while (n2 < n) n2 *= 2;
 		assert((mod - 1) % n2 == 0);
-		vector<mint> root(n2+1), a2(n2, 0), b2(n2, 0);
-		root[0] = 1;
-		mint g = _pr.pow((mod-1)/n2);
-		for (int i = 0; i < n2; i++) root[i+1] = root[i] * g;
+		const vector<mint> &root = _root(n2);
+		vector<mint> a2(n2, 0), b2(n2, 0);
 		for (int i = 0; i < a.size(); i++) a2[i] = a[i];
 		for (int i = 0; i < b.size(); i++) b2[i] = b[i];
 		_ntt(a2, root);
 		_ntt(b2, root);
-		for (int i = 0; i < n2; i++) a2[i] *= b2[i];
+		mint_simd<mint>::mul(a2.data(), b2.data(), n2);
 		_intt(a2, root);
-		mint ni = mint(n2).inv();
-		vector<mint> c(n);
-		for (int i = 0; i < n; i++) c[i] = a2[i] * ni;
-		return c;
+		a2.resize(n);
+		mint_simd<mint>::scale(a2.data(), mint(n2).inv(), n);
+		return a2;
 	}
 
 	/**
@@ -76,19 +75,23 @@ struct ntt_friendly_convolution_base {
 	 */
 	template<gnu_integral T>
 	vector<T> operator()(const vector<T> &a, const vector<T> &b) const {
+		if (!a.empty() && !b.empty() && min(a.size(), b.size()) <= _naive_threshold) {
+			vector<mint> c = _naive(vector<mint>(a.begin(), a.end()), vector<mint>(b.begin(), b.end()));
+			vector<T> res(c.size());
+			for (int i = 0; i < c.size(); i++) res[i] = c[i].val();
+			return res;
+		}
 		int n = a.size() + b.size() - 1;
 		int n2 = 1;
 		while (n2 < n) n2 *= 2;
 		assert((mod - 1) % n2 == 0);
-		vector<mint> root(n2+1), a2(n2, 0), b2(n2, 0);
-		root[0] = 1;
-		mint g = _pr.pow((mod-1)/n2);
-		for (int i = 0; i < n2; i++) root[i+1] = root[i] * g;
+		const vector<mint> &root = _root(n2);
+		vector<mint> a2(n2, 0), b2(n2, 0);
 		for (int i = 0; i < a.size(); i++) a2[i] = a[i];
 		for (int i = 0; i < b.size(); i++) b2[i] = b[i];
 		_ntt(a2, root);
 		_ntt(b2, root);
-		for (int i = 0; i < n2; i++) a2[i] *= b2[i];
+		mint_simd<mint>::mul(a2.data(), b2.data(), n2);
 		_intt(a2, root);
 		mint ni = mint(n2).inv();
 		vector<T> c(n);
@@ -105,10 +108,7 @@ struct ntt_friendly_convolution_base {
 	vector<mint> large(const vector<mint> &a, const vector<mint> &b) const {
 		int n = a.size() + b.size() - 1;
 		int n2 = 1 << __builtin_ctz(mod-1);
-		vector<mint> root(n2+1);
-		root[0] = 1;
-		mint g = _pr.pow((mod-1)/n2);
-		for (int i = 0; i < n2; i++) root[i+1] = root[i] * g;
+		const vector<mint> &root = _root(n2);
 		vector<vector<mint>> as, bs;
 		for (int i = 0; i < a.size(); i += n2/2) {
 			vector<mint> a2(n2, 0);
@@ -127,7 +127,7 @@ struct ntt_friendly_convolution_base {
 		vector<vector<mint>> cs(as.size()+bs.size()-1, vector<mint>(n2, 0));
 		for (int i = 0; i < as.size(); i++) {
 			for (int j = 0; j < bs.size(); j++) {
-				for (int k = 0; k < n2; k++) cs[i+j][k] += as[i][k] * bs[j][k];
+				mint_simd<mint>::fma(cs[i+j].data(), as[i].data(), bs[j].data(), n2);
 			}
 		}
 		for (int i = 0; i < cs.size(); i++) _intt(cs[i], root);
@@ -137,8 +137,7 @@ struct ntt_friendly_convolution_base {
 			int len = min<int>(c.size()-offset, n2);
 			for (int j = 0; j < len; j++) c[j+offset] += cs[i][j];
 		}
-		mint ni = mint(n2).inv();
-		for (int i = 0; i < n; i++) c[i] *= ni;
+		mint_simd<mint>::scale(c.data(), mint(n2).inv(), n);
 		return c;
 	}
 
@@ -152,10 +151,7 @@ struct ntt_friendly_convolution_base {
 	vector<T> large(const vector<T> &a, const vector<T> &b) const {
 		int n = a.size() + b.size() - 1;
 		int n2 = 1 << __builtin_ctz(mod-1);
-		vector<mint> root(n2+1);
-		root[0] = 1;
-		mint g = _pr.pow((mod-1)/n2);
-		for (int i = 0; i < n2; i++) root[i+1] = root[i] * g;
+		const vector<mint> &root = _root(n2);
 		vector<vector<mint>> as, bs;
 		for (int i = 0; i < a.size(); i += n2/2) {
 			vector<mint> a2(n2, 0);
@@ -174,7 +170,7 @@ struct ntt_friendly_convolution_base {
 		vector<vector<mint>> cs(as.size()+bs.size()-1, vector<mint>(n2, 0));
 		for (int i = 0; i < as.size(); i++) {
 			for (int j = 0; j < bs.size(); j++) {
-				for (int k = 0; k < n2; k++) cs[i+j][k] += as[i][k] * bs[j][k];
+				mint_simd<mint>::fma(cs[i+j].data(), as[i].data(), bs[j].data(), n2);
 			}
 		}
 		for (int i = 0; i < cs.size(); i++) _intt(cs[i], root);
@@ -189,9 +185,60 @@ struct ntt_friendly_convolution_base {
 		for (int i = 0; i < n; i++) c[i] = (cm[i] * ni).val();
 		return c;
 	}
+
+	/**
+	 * @brief 長さが 2 冪の `v` をその場で NTT によって変換する。結果はビット反転順に並ぶ。すなわち、前半 `v.size()/2` 項は `v` を `x^(v.size()/2)-1` で割った余りの変換と一致し、 `2i` 項目と `2i+1` 項目は互いに符号が逆の点での値である。
+	 *
+	 * O(N log N)
+	 * @param v `mod = d*2^s + 1` のとき、長さが `2^s` 以下の 2 冪である `vector`
+	 */
+	void ntt(vector<mint> &v) const {
+		assert((mod - 1) % v.size() == 0);
+		const vector<mint> &root = _root(v.size());
+		_ntt(v, root);
+	}
+
+	/**
+	 * @brief `ntt` の逆変換をその場で行う。長さによる除算も行う。
+	 *
+	 * O(N log N)
+	 * @param v `mod = d*2^s + 1` のとき、長さが `2^s` 以下の 2 冪である `vector`
+	 */
+	void intt(vector<mint> &v) const {
+		int n2 = v.size();
+		assert((mod - 1) % n2 == 0);
+		const vector<mint> &root = _root(n2);
+		_intt(v, root);
+		mint_simd<mint>::scale(v.data(), mint(n2).inv(), n2);
+	}
 private:
+	constexpr static int _naive_threshold = 32;
 	constexpr static mint _pr = mint::primitive_root();
-	void _ntt(vector<mint> &v, vector<mint> &root) const {
+	// 長さ 2^e の変換で使う 1 の原始 2^e 乗根の冪の表。スレッドごとに 1 度だけ作る。
+	inline static thread_local vector<vector<mint>> _roots;
+	const vector<mint> &_root(int n2) const {
+		int e = __builtin_ctz(n2);
+		if (_roots.size() <= e) _roots.resize(e+1);
+		vector<mint> &root = _roots[e];
+		if (root.empty()) {
+			root.resize(n2+1);
+			root[0] = 1;
+			mint g = _pr.pow((mod-1)/n2);
+			for (int i = 0; i < n2; i++) root[i+1] = root[i] * g;
+		}
+		return root;
+	}
+	vector<mint> _naive(const vector<mint> &a, const vector<mint> &b) const {
+		// c[k] = \sum a[i] b[k-i] を、 b を反転した列との内積として求める。
+		int n = a.size(), m = b.size();
+		vector<mint> rb(b.rbegin(), b.rend()), c(n+m-1);
+		for (int k = 0; k < n+m-1; k++) {
+			int lo = max(0, k-m+1), hi = min(k, n-1);
+			c[k] = mint_simd<mint>::dot(a.data()+lo, rb.data()+m-1-k+lo, hi-lo+1);
+		}
+		return c;
+	}
+	void _ntt(vector<mint> &v, const vector<mint> &root) const {
 		if (v.size() <= 1) return;
 		if (v.size() == 2) {
 			mint v0 = v[0];
@@ -238,7 +285,7 @@ private:
 			b >>= 2;
 		}
 	}
-	void _intt(vector<mint> &v, vector<mint> &root) const {
+	void _intt(vector<mint> &v, const vector<mint> &root) const {
 		if (v.size() <= 1) return;
 		if (v.size() == 2) {
 			mint v0 = v[0];
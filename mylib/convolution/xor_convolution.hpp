@@ -35,6 +35,18 @@ void _walsh_hadamard(vector<T> &v) {
 	}
 }
 
+template<class T>
+void _walsh_hadamard_normalize(vector<T> &v) {
+	// 逆元を持つ型では、逆元を 1 回だけ求めて掛ける。
+	int n2 = v.size();
+	if constexpr (requires(T x) { x.inv(); }) {
+		T in = T(n2).inv();
+		for (int i = 0; i < n2; i++) v[i] *= in;
+	} else {
+		for (int i = 0; i < n2; i++) v[i] /= n2;
+	}
+}
+
 /**
  * @brief 高速 Walsh-Hadamard 変換にょって XOR convolution を行う。
  *
@@ -55,6 +67,89 @@ vector<T> xor_convolution(const vector<T> &a, const vector<T> &b) {
 	_walsh_hadamard(b2);
 	for (int i = 0; i < n2; i++) a2[i] *= b2[i];
 	_walsh_hadamard(a2);
-	for (int i = 0; i < n2; i++) a2[i] /= n2;
+	_walsh_hadamard_normalize(a2);
 	return a2;
-}
\ No newline at end of file
+}
+
+/**
+ * @brief 高速 Walsh-Hadamard 変換後の値を保持するクラス。同じ列を何度も畳み込む場合や XOR convolution の冪乗を求める場合に、変換を使い回せる。
+ *
+ * @tparam T 環
+ */
+template<class T>
+struct xor_transform {
+	/**
+	 * @brief `a` を変換した値で初期化する。
+	 *
+	 * O(N log N)
+	 * @param a `vector`
+	 * @param n 長さ。 `a.size()` と `n` 以上の最小の 2 冪に切り上げられる。
+	 */
+	xor_transform(const vector<T> &a, int n=0) {
+		int n2 = 1;
+		while (n2 < a.size() || n2 < n) n2 *= 2;
+		_v.assign(n2, 0);
+		for (int i = 0; i < a.size(); i++) _v[i] = a[i];
+		_walsh_hadamard(_v);
+	}
+
+	/**
+	 * @brief 変換後の列の長さを返す。
+	 *
+	 * @return 長さ
+	 */
+	int size() const {
+		return _v.size();
+	}
+
+	/**
+	 * @brief 各点積を取る。これは元の列どうしの XOR convolution に対応する。長さが等しい必要がある。
+	 *
+	 * O(N)
+	 * @param a 変換後の列
+	 * @return `*this`
+	 */
+	xor_transform &operator*=(const xor_transform &a) {
+		assert(_v.size() == a._v.size());
+		for (int i = 0; i < _v.size(); i++) _v[i] *= a._v[i];
+		return *this;
+	}
+	xor_transform operator*(const xor_transform &a) const { return xor_transform(*this) *= a; }
+
+	/**
+	 * @brief 各点で冪乗を取る。これは元の列の XOR convolution に関する `t` 乗に対応する。
+	 *
+	 * O(N log t)
+	 * @param t 非負の指数
+	 * @return 冪乗
+	 */
+	xor_transform pow(long long t) const {
+		assert(t >= 0);
+		xor_transform res(*this);
+		for (int i = 0; i < _v.size(); i++) {
+			T x = 1;
+			T mul = _v[i];
+			for (long long s = t; s; s >>= 1) {
+				if (s & 1) x *= mul;
+				mul *= mul;
+			}
+			res._v[i] = x;
+		}
+		return res;
+	}
+
+	/**
+	 * @brief 逆変換を行い、元の列に戻す。
+	 *
+	 * O(N log N)
+	 * @return 長さ `size()` の `vector`
+	 */
+	vector<T> inverse() const {
+		vector<T> res = _v;
+		_walsh_hadamard(res);
+		_walsh_hadamard_normalize(res);
+		return res;
+	}
+private:
+	vector<T> _v;
+};
\ No newline at end of file
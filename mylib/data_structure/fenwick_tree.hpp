@@ -20,6 +20,8 @@ using namespace std;
  */
 template<class T>
 struct fenwick_tree {
+	fenwick_tree() : fenwick_tree(0) {}
+
 	/**
 	 * @brief Fenwick 木をサイズ `n` で初期化する。要素はすべて 0 である。
 	 *
@@ -40,8 +40,17 @@ struct matrix {
 	matrix<T> &operator*=(const matrix<T> &a) {
 		assert(w == a.h);
 		matrix<T> res(h, a.w);
-		for (int i = 0; i < h; i++) for (int k = 0; k < w; k++) for (int j = 0; j < a.w; j++) {
-			res[i][j] += d[i][k] * a[k][j];
+		if constexpr (requires (const T *p) { T::dot(p, p, 0); }) {
+			// 還元をまとめて行う内積を使うため、 a を転置して列を連続に並べる。
+			matrix<T> at(a.w, a.h);
+			for (int k = 0; k < a.h; k++) for (int j = 0; j < a.w; j++) at[j][k] = a[k][j];
+			for (int i = 0; i < h; i++) for (int j = 0; j < a.w; j++) {
+				res[i][j] = T::dot(d[i].data(), at[j].data(), w);
+			}
+		} else {
+			for (int i = 0; i < h; i++) for (int k = 0; k < w; k++) for (int j = 0; j < a.w; j++) {
+				res[i][j] += d[i][k] * a[k][j];
+			}
 		}
 		return *this = res;
 	}
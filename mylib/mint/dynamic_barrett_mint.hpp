@@ -0,0 +1,232 @@
+/**
+ * @file dynamic_barrett_mint.hpp
+ * @author rii922
+ * @brief Barrett 還元によって自動で剰余を取る整数型。 `mod` が実行時に決まり、偶数でもよい場合に使用する。
+ * @date 2026-10-19
+ */
+
+#include <bits/stdc++.h>
+#include "../custom_concepts.hpp"
+#include "mint_batch.hpp"
+using namespace std;
+
+/// EXPAND FROM HERE
+
+/**
+ * @brief Barrett 還元によって自動で剰余を取る 32 bit 整数。 `mod` が実行時に決まる場合に使用する。値は常に `[0, mod)` で保持するので、構築と `val()` に変換の手間がかからない。インターフェースは `dynamic_montgomery_mint` と同じである。
+ *
+ * @tparam id 型を区別するための ID 。同じ ID を持つインスタンスは同じ `mod` を持つ。 `mod` はスレッドごとに保持されるので、スレッドごとに別の `mod` を設定できる。
+ */
+template<int id>
+struct dynamic_barrett_mint {
+	using mint = dynamic_barrett_mint<id>;
+	static thread_local uint32_t mod;
+	static uint32_t get_mod() {
+		return mod;
+	}
+
+	/**
+	 * @brief 呼び出したスレッドの `mod` を設定する。そのスレッドでのインスタンス生成前に呼び出す必要がある。
+	 *
+	 * @param m `1 <= m <= 2^31` である整数
+	 */
+	static void set_mod(uint32_t m) {
+		assert(1 <= m && m <= 1u << 31);
+		mod = m;
+		_im = UINT64_MAX / m;
+		_invs.clear();
+	}
+	static mint primitive_root();
+	static long long discrete_log(mint x, mint y);
+
+	/**
+	 * @brief 生存している間だけ呼び出したスレッドの `mod` を切り替え、破棄されるときに元の `mod` と逆元の表に戻す。
+	 */
+	struct scoped_mod {
+		/**
+		 * @param m `1 <= m <= 2^31` である整数
+		 */
+		scoped_mod(uint32_t m) : _mod(mod), _im(mint::_im), _invs(move(mint::_invs)) {
+			set_mod(m);
+		}
+		~scoped_mod() {
+			mod = _mod;
+			mint::_im = _im;
+			mint::_invs = move(_invs);
+		}
+		scoped_mod(const scoped_mod &) = delete;
+		scoped_mod &operator=(const scoped_mod &) = delete;
+	private:
+		uint32_t _mod;
+		uint64_t _im;
+		vector<mint> _invs;
+	};
+	dynamic_barrett_mint() : _x(0) {}
+	template<gnu_signed_integral T> dynamic_barrett_mint(T x) {
+		if constexpr (sizeof(T) > sizeof(uint64_t)) x %= mod;
+		_x = _reduce(x < 0 ? -uint64_t(x) : uint64_t(x));
+		if (x < 0 && _x) _x = mod - _x;
+	}
+	template<gnu_unsigned_integral T> dynamic_barrett_mint(T x) {
+		if constexpr (sizeof(T) > sizeof(uint64_t)) x %= mod;
+		_x = _reduce(x);
+	}
+	uint32_t val() const {
+		return _x;
+	}
+	mint operator+() const { return mint(*this); }
+	mint operator-() const { return mint(0) - mint(*this); }
+	mint &operator+=(const mint &a) {
+		if ((_x += a._x) >= mod) _x -= mod;
+		return *this;
+	}
+	mint &operator-=(const mint &a) {
+		if (_x < a._x) _x += mod;
+		_x -= a._x;
+		return *this;
+	}
+	mint &operator*=(const mint &a) {
+		_x = _reduce(uint64_t(_x) * a._x);
+		return *this;
+	}
+	mint &operator++() {
+		*this += 1;
+		return *this;
+	}
+	mint operator++(int) {
+		mint temp = *this;
+		++*this;
+		return temp;
+	}
+	mint &operator--() {
+		*this -= 1;
+		return *this;
+	}
+	mint operator--(int) {
+		mint temp = *this;
+		--*this;
+		return temp;
+	}
+	mint operator+(const mint &a) const { return mint(*this) += a; }
+	mint operator-(const mint &a) const { return mint(*this) -= a; }
+	mint operator*(const mint &a) const { return mint(*this) *= a; }
+	friend mint operator+(const int64_t a, const mint b) { return mint(a) + b; }
+	friend mint operator-(const int64_t a, const mint b) { return mint(a) - b; }
+	friend mint operator*(const int64_t a, const mint b) { return mint(a) * b; }
+
+	/**
+	 * @brief 繰り返し 2 乗法によって冪乗を計算する。負の冪乗では逆元の冪乗となる。
+	 *
+	 * @param t 指数
+	 * @return 冪乗
+	 */
+	mint pow(int64_t t) const {
+		if (t < 0) return pow(-t).inv();
+		mint res = 1;
+		mint mul = *this;
+		while (t) {
+			if (t & 1) res *= mul;
+			mul *= mul;
+			t >>= 1;
+		}
+		return res;
+	}
+
+	/**
+	 * @brief 拡張ユークリッドの互除法によって逆元を求める。値と `mod` が互いに素である必要がある。
+	 *
+	 * @return 逆元
+	 */
+	mint inv() const {
+		int64_t x = _x;
+		int64_t y = mod;
+		int64_t u = 1;
+		int64_t v = 0;
+		while (y) {
+			int64_t t = x / y;
+			x -= y * t;
+			u -= v * t;
+			swap(x, y);
+			swap(u, v);
+		}
+		assert(x == 1);
+		return mint(u);
+	}
+
+	/**
+	 * @brief `a` の各要素の逆元を求める。 `mint_batch::batch_inv` を参照。
+	 *
+	 * O(N + log mod)
+	 * @param a 値の列
+	 * @return 各要素の逆元の列
+	 */
+	static vector<mint> batch_inv(const vector<mint> &a) {
+		return mint_batch<mint>::batch_inv(a);
+	}
+
+	/**
+	 * @brief `\sum a[i] b[i]` を求める。 `mint_batch::dot` によって積を足し合わせ、最後に 1 回だけ剰余を取る。
+	 *
+	 * O(N)
+	 * @param a, b 長さ `n` の列の先頭
+	 * @param n 長さ
+	 * @return 内積
+	 */
+	static mint dot(const mint *a, const mint *b, int n) {
+		return mint_batch<mint>::dot(a, b, n, &mint::_x, [](__uint128_t s) {
+			// 各積は mod^2 <= 2^62 以下なので、上位 64 bit は小さい。 2^64 を mod で割った余りを掛けて下位と合わせる。
+			uint64_t r64 = (UINT64_MAX % mod + 1) % mod;
+			uint32_t x = _reduce(uint64_t(s >> 64) % mod * r64) + _reduce(uint64_t(s));
+			mint res;
+			res._x = x >= mod ? x - mod : x;
+			return res;
+		});
+	}
+
+	/**
+	 * @brief `1, ..., n` の逆元の表を返す。表はスレッド内の呼び出し間で共有される。 `mint_batch::inv_table` を参照。
+	 *
+	 * ならし O(N)
+	 * @param n 上限
+	 * @return `i` 番目が `1/i` である長さ `n+1` 以上の表。 0 番目は 0 である。次に表が伸ばされるまで有効である。
+	 */
+	static const vector<mint> &inv_table(int n) {
+		return mint_batch<mint>::inv_table(_invs, n);
+	}
+	mint &operator/=(const mint &a) {
+		*this *= a.inv();
+		return *this;
+	}
+	mint operator/(const mint &a) const { return mint(*this) /= a; }
+	friend mint operator/(const int64_t a, const mint b) { return mint(a) / b; }
+	bool operator==(const mint &a) const {
+		return _x == a._x;
+	}
+	bool operator!=(const mint &a) const {
+		return _x != a._x;
+	}
+	friend istream &operator>>(istream &is, mint &a) {
+		int64_t x;
+		is >> x;
+		a = mint(x);
+		return is;
+	}
+	friend ostream &operator<<(ostream &os, const mint &a) {
+		os << a.val();
+		return os;
+	}
+private:
+	static thread_local uint64_t _im;
+	inline static thread_local vector<mint> _invs;
+	uint32_t _x;
+	static uint32_t _reduce(const uint64_t &a) {
+		// _im = floor((2^64-1) / mod) より、商の推定値は真の商か 1 小さい値になる。
+		uint64_t q = (__uint128_t(a) * _im) >> 64;
+		uint64_t r = a - q * mod;
+		return r >= mod ? r - mod : r;
+	}
+};
+template<int id> thread_local uint32_t dynamic_barrett_mint<id>::mod = 1;
+template<int id> thread_local uint64_t dynamic_barrett_mint<id>::_im = UINT64_MAX;
+
+// using mint = dynamic_barrett_mint<-1>;
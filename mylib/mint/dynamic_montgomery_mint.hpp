@@ -7,6 +7,7 @@
 
 #include <bits/stdc++.h>
 #include "../custom_concepts.hpp"
+#include "mint_batch.hpp"
 using namespace std;
 
 /// EXPAND FROM HERE
@@ -18,19 +19,19 @@ using namespace std;
  * @tparam _uint `mod*4` を表現可能な符号無し整数型
  * @tparam _long `_int` の倍の精度の符号付き整数型
  * @tparam _ulong `_uint` の倍の精度の符号無し整数型
- * @tparam id 型を区別するための ID 。同じ ID を持つインスタンスは同じ `mod` を持つ。
+ * @tparam id 型を区別するための ID 。同じ ID を持つインスタンスは同じ `mod` を持つ。 `mod` はスレッドごとに保持されるので、スレッドごとに別の `mod` を設定できる。
  */
 template<gnu_signed_integral _int, gnu_unsigned_integral _uint, gnu_signed_integral _long, gnu_unsigned_integral _ulong, int id>
 requires (sizeof(_int) == sizeof(_uint)) && (sizeof(_long) == sizeof(_ulong)) && (sizeof(_int)*2 == sizeof(_long))
 struct dynamic_montgomery_mint {
 	using mint = dynamic_montgomery_mint<_int, _uint, _long, _ulong, id>;
-	static _uint mod;
+	static thread_local _uint mod;
 	static _uint get_mod() {
 		return mod;
 	}
 
 	/**
-	 * @brief `mod` を設定する。インスタンス生成前に呼び出す必要がある。
+	 * @brief 呼び出したスレッドの `mod` を設定する。そのスレッドでのインスタンス生成前に呼び出す必要がある。
 	 *
 	 * @param m `mod*4` が `_uint` に収まるような奇数
 	 */
@@ -41,9 +42,33 @@ struct dynamic_montgomery_mint {
 		_r2 = -_ulong(mod) % mod;
 		_ninv = mod;
 		while (mod * _ninv != 1) _ninv *= _uint(2) - mod * _ninv;
+		_invs.clear();
 	}
 	static mint primitive_root();
 	static long long discrete_log(mint x, mint y);
+
+	/**
+	 * @brief 生存している間だけ呼び出したスレッドの `mod` を切り替え、破棄されるときに元の `mod` と逆元の表に戻す。
+	 */
+	struct scoped_mod {
+		/**
+		 * @param m `mod*4` が `_uint` に収まるような奇数
+		 */
+		scoped_mod(_uint m) : _mod(mod), _r2(mint::_r2), _ninv(mint::_ninv), _invs(move(mint::_invs)) {
+			set_mod(m);
+		}
+		~scoped_mod() {
+			mod = _mod;
+			mint::_r2 = _r2;
+			mint::_ninv = _ninv;
+			mint::_invs = move(_invs);
+		}
+		scoped_mod(const scoped_mod &) = delete;
+		scoped_mod &operator=(const scoped_mod &) = delete;
+	private:
+		_uint _mod, _r2, _ninv;
+		vector<mint> _invs;
+	};
 	dynamic_montgomery_mint() : _xr(0) {}
 	template<gnu_signed_integral T> dynamic_montgomery_mint(T x) : _xr(_reduce(_ulong(x%_long(mod)+mod)*_r2)) {}
 	template<gnu_unsigned_integral T> dynamic_montgomery_mint(T x) : _xr(_reduce(_ulong(x%_ulong(mod)+mod)*_r2)) {}
@@ -127,6 +152,51 @@ struct dynamic_montgomery_mint {
 		}
 		return mint(u);
 	}
+
+	/**
+	 * @brief `a` の各要素の逆元を求める。 `mint_batch::batch_inv` を参照。
+	 *
+	 * O(N + log mod)
+	 * @param a 値の列
+	 * @return 各要素の逆元の列
+	 */
+	static vector<mint> batch_inv(const vector<mint> &a) {
+		return mint_batch<mint>::batch_inv(a);
+	}
+
+	/**
+	 * @brief `\sum a[i] b[i]` を求める。 32 bit の場合は `mint_batch::dot` によって Montgomery 表現どうしの積を足し合わせ、最後に 1 回だけ還元する。
+	 *
+	 * O(N)
+	 * @param a, b 長さ `n` の列の先頭
+	 * @param n 長さ
+	 * @return 内積
+	 */
+	static mint dot(const mint *a, const mint *b, int n) {
+		if constexpr (sizeof(_uint) == 4) {
+			// 各積は 4 mod^2 < 2^62 未満で、和は \sum ab R^2 と合同である。 2^64 = _r2 (mod mod) で mod R 未満に落としてから還元する。
+			return mint_batch<mint>::dot(a, b, n, &mint::_xr, [](__uint128_t s) {
+				mint res;
+				res._xr = res._reduce(_ulong(s >> 64) % mod * _r2 + _ulong(s) % mod);
+				return res;
+			});
+		} else {
+			mint res;
+			for (int i = 0; i < n; i++) res += a[i] * b[i];
+			return res;
+		}
+	}
+
+	/**
+	 * @brief `1, ..., n` の逆元の表を返す。表はスレッド内の呼び出し間で共有される。 `mint_batch::inv_table` を参照。
+	 *
+	 * ならし O(N)
+	 * @param n 上限
+	 * @return `i` 番目が `1/i` である長さ `n+1` 以上の表。 0 番目は 0 である。次に表が伸ばされるまで有効である。
+	 */
+	static const vector<mint> &inv_table(int n) {
+		return mint_batch<mint>::inv_table(_invs, n);
+	}
 	mint &operator/=(const mint &a) {
 		*this *= a.inv();
 		return *this;
@@ -151,7 +221,8 @@ struct dynamic_montgomery_mint {
 		return os;
 	}
 private:
-	static _uint _r2, _ninv;
+	static thread_local _uint _r2, _ninv;
+	inline static thread_local vector<mint> _invs;
 	constexpr static _uint _sz = sizeof(_uint) * 8;
 	_uint _xr;
 	_uint _reduce(const _ulong &a) const {
@@ -160,13 +231,13 @@ private:
 };
 template<gnu_signed_integral _int, gnu_unsigned_integral _uint, gnu_signed_integral _long, gnu_unsigned_integral _ulong, int id>
 requires (sizeof(_int) == sizeof(_uint)) && (sizeof(_long) == sizeof(_ulong)) && (sizeof(_int)*2 == sizeof(_long))
-_uint dynamic_montgomery_mint<_int, _uint, _long, _ulong, id>::mod = 0;
+thread_local _uint dynamic_montgomery_mint<_int, _uint, _long, _ulong, id>::mod = 0;
 template<gnu_signed_integral _int, gnu_unsigned_integral _uint, gnu_signed_integral _long, gnu_unsigned_integral _ulong, int id>
 requires (sizeof(_int) == sizeof(_uint)) && (sizeof(_long) == sizeof(_ulong)) && (sizeof(_int)*2 == sizeof(_long))
-_uint dynamic_montgomery_mint<_int, _uint, _long, _ulong, id>::_r2 = 0;
+thread_local _uint dynamic_montgomery_mint<_int, _uint, _long, _ulong, id>::_r2 = 0;
 template<gnu_signed_integral _int, gnu_unsigned_integral _uint, gnu_signed_integral _long, gnu_unsigned_integral _ulong, int id>
 requires (sizeof(_int) == sizeof(_uint)) && (sizeof(_long) == sizeof(_ulong)) && (sizeof(_int)*2 == sizeof(_long))
-_uint dynamic_montgomery_mint<_int, _uint, _long, _ulong, id>::_ninv = 0;
+thread_local _uint dynamic_montgomery_mint<_int, _uint, _long, _ulong, id>::_ninv = 0;
 
 /**
  * @brief Montgomery 乗算によって自動で剰余を取る 32 bit 整数。
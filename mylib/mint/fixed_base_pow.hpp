@@ -0,0 +1,65 @@
+/**
+ * @file fixed_base_pow.hpp
+ * @author rii922
+ * @brief 底を固定した冪乗を前計算の表によって高速に求める
+ * @date 2026-10-19
+ */
+
+#include <bits/stdc++.h>
+using namespace std;
+
+/// EXPAND FROM HERE
+
+/**
+ * @brief 底 `b` を固定し、指数 `k` が `[lo, hi]` に収まる冪乗 `b^k` を 1 回の乗算で求める。 `k = q*2^t + r` と分け、 `b^r` と `b^(q*2^t)` の表を持つ (baby-step giant-step) 。
+ *
+ * @tparam mint 自動で剰余を取る整数型
+ */
+template<class mint>
+struct fixed_base_pow {
+	fixed_base_pow() : fixed_base_pow(1, 0) {}
+
+	/**
+	 * @brief 底 `b` と指数の範囲 `[lo, hi]` で初期化する。
+	 *
+	 * O(sqrt(max(hi, -lo)) + log mod)
+	 * @param b 底。 `lo < 0` の場合は逆元を持つ必要がある
+	 * @param hi 指数の上限。 0 以上である必要がある
+	 * @param lo 指数の下限。 0 以下である必要がある
+	 */
+	fixed_base_pow(mint b, long long hi, long long lo = 0) : _hi(hi), _lo(lo) {
+		assert(lo <= 0 && 0 <= hi);
+		long long m = max(hi, -lo) + 1;
+		_t = 0;
+		while ((1LL << (2*_t)) < m) _t++;
+		_build(b, hi, _small, _large);
+		if (lo < 0) _build(b.inv(), -lo, _ismall, _ilarge);
+	}
+
+	/**
+	 * @brief `b^k` を求める。
+	 *
+	 * O(1)
+	 * @param k `[lo, hi]` に含まれる指数
+	 * @return `b^k`
+	 */
+	mint operator()(long long k) const {
+		assert(_lo <= k && k <= _hi);
+		if (k >= 0) return _large[k >> _t] * _small[k & ((1LL << _t) - 1)];
+		k = -k;
+		return _ilarge[k >> _t] * _ismall[k & ((1LL << _t) - 1)];
+	}
+private:
+	long long _hi, _lo;
+	int _t;
+	vector<mint> _small, _large, _ismall, _ilarge;
+	void _build(mint b, long long n, vector<mint> &small, vector<mint> &large) const {
+		small.resize(1LL << _t);
+		large.resize((n >> _t) + 1);
+		small[0] = 1;
+		for (int i = 1; i < small.size(); i++) small[i] = small[i-1] * b;
+		mint g = small.back() * b;
+		large[0] = 1;
+		for (int i = 1; i < large.size(); i++) large[i] = large[i-1] * g;
+	}
+};
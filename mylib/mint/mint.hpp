@@ -5,11 +5,20 @@ using namespace std;
 
 template<int mod>
 struct static_mint {
+	static_assert(0 < mod);
 	using mint = static_mint<mod>;
-	static_mint(long long x = 0) : _x((x%mod+mod)%mod) {}
+	static_mint(long long x = 0) {
+		// 符号で分岐すると予測が外れやすいので、負の場合だけ mod を足すマスクで補正する。
+		long long r = x % mod;
+		_x = r + (r >> 63 & mod);
+	}
 	long long val() const { return _x; }
-	mint operator+() const { return mint(_x); }
-	mint operator-() const { return mint(-_x); }
+	mint operator+() const { return mint(*this); }
+	mint operator-() const {
+		mint res;
+		res._x = (mod - _x) & -uint32_t(_x != 0);
+		return res;
+	}
 	mint &operator+=(const mint a) {
 		if ((_x += a._x) >= mod) _x -= mod;
 		return *this;
@@ -19,7 +28,8 @@ struct static_mint {
 		return *this;
 	}
 	mint &operator*=(const mint a) {
-		(_x *= a._x) %= mod;
+		// mod が定数なので、符号無しの剰余は除算命令を使わない乗算とシフトになる。
+		_x = uint64_t(_x) * a._x % mod;
 		return *this;
 	}
 	mint &operator++() {
@@ -71,7 +81,7 @@ struct static_mint {
 		return os;
 	}
 private:
-	long long _x;
+	uint32_t _x;
 };
 using mint = static_mint<1000000007>;
-using mint = static_mint<998244353>;
\ No newline at end of file
+// using mint = static_mint<998244353>;
\ No newline at end of file
@@ -0,0 +1,86 @@
+/**
+ * @file mint_batch.hpp
+ * @author rii922
+ * @brief 自動で剰余を取る整数型に共通する、列に対する演算
+ * @date 2026-10-19
+ */
+
+#include <bits/stdc++.h>
+using namespace std;
+
+/// EXPAND FROM HERE
+
+/**
+ * @brief 自動で剰余を取る整数型に共通する、列に対する演算をまとめたクラス。各整数型の `batch_inv` 、 `inv_table` 、 `dot` はこれを呼び出し、内部表現に依存する還元だけを自分で持つ。
+ *
+ * @tparam mint 自動で剰余を取る整数型
+ */
+template<class mint>
+struct mint_batch {
+	/**
+	 * @brief `a` の各要素の逆元を、累積積と 1 回の逆元の計算によって求める。 0 の要素は 0 のままとする。 0 でない要素は全て `mod` と互いに素である必要がある。
+	 *
+	 * O(N + log mod)
+	 * @param a 値の列
+	 * @return 各要素の逆元の列
+	 */
+	static vector<mint> batch_inv(const vector<mint> &a) {
+		int n = a.size();
+		vector<mint> res(n);
+		mint p = 1;
+		for (int i = 0; i < n; i++) {
+			res[i] = p;
+			if (a[i] != 0) p *= a[i];
+		}
+		p = p.inv();
+		for (int i = n-1; i >= 0; i--) {
+			if (a[i] == 0) {
+				res[i] = 0;
+				continue;
+			}
+			res[i] *= p;
+			p *= a[i];
+		}
+		return res;
+	}
+
+	/**
+	 * @brief `1, ..., n` の逆元の表 `invs` を `1/i = -(mod/i) / (mod%i)` によって必要に応じて倍々に伸ばす。 `mod` が `n` より大きい素数である必要がある。
+	 *
+	 * ならし O(N)
+	 * @param invs `i` 番目が `1/i` で 0 番目が 0 である表。空でもよい
+	 * @param n 上限
+	 * @return 長さ `n+1` 以上に伸ばされた `invs`
+	 */
+	static const vector<mint> &inv_table(vector<mint> &invs, int n) {
+		auto mod = mint::get_mod();
+		assert(0 <= n && (unsigned long long)n < mod);
+		if (invs.size() > n) return invs;
+		int m = invs.size();
+		if (m < 2) {
+			invs = {0, 1};
+			m = 2;
+		}
+		invs.resize(max(n+1, m*2));
+		for (int i = m; i < invs.size(); i++) invs[i] = -invs[mod % i] * mint(mod / i);
+		return invs;
+	}
+
+	/**
+	 * @brief `\sum a[i] b[i]` を、内部表現どうしの積を 128 bit 整数に足し合わせて求める。還元は最後に 1 回だけ行う。
+	 *
+	 * O(N)
+	 * @param a, b 長さ `n` の列の先頭
+	 * @param n 長さ
+	 * @param raw 32 bit 以下の内部表現を持つメンバへのポインタ
+	 * @param reduce 内部表現どうしの積の和を受け取り、対応する値を返す関数
+	 * @return 内積
+	 */
+	template<class U, class F>
+	static mint dot(const mint *a, const mint *b, int n, U mint::*raw, F reduce) {
+		static_assert(sizeof(U) <= 4);
+		__uint128_t s = 0;
+		for (int i = 0; i < n; i++) s += uint64_t(a[i].*raw) * (b[i].*raw);
+		return reduce(s);
+	}
+};
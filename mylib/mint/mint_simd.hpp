@@ -0,0 +1,230 @@
+/**
+ * @file mint_simd.hpp
+ * @author rii922
+ * @brief 自動で剰余を取る整数の列に対する要素ごとの演算
+ * @date 2026-10-19
+ */
+
+#include <bits/stdc++.h>
+#include "montgomery_mint.hpp"
+using namespace std;
+
+/// EXPAND FROM HERE
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <immintrin.h>
+#endif
+
+/**
+ * @brief 自動で剰余を取る整数の列に対する要素ごとの演算をまとめたクラス。一般の型では 1 要素ずつ計算する。
+ *
+ * @tparam mint 自動で剰余を取る整数型
+ */
+template<class mint>
+struct mint_simd {
+	/**
+	 * @brief `a[i] += b[i]` を行う。
+	 *
+	 * O(N)
+	 */
+	static void add(mint *a, const mint *b, int n) {
+		for (int i = 0; i < n; i++) a[i] += b[i];
+	}
+
+	/**
+	 * @brief `a[i] -= b[i]` を行う。
+	 *
+	 * O(N)
+	 */
+	static void sub(mint *a, const mint *b, int n) {
+		for (int i = 0; i < n; i++) a[i] -= b[i];
+	}
+
+	/**
+	 * @brief `a[i] *= b[i]` を行う。
+	 *
+	 * O(N)
+	 */
+	static void mul(mint *a, const mint *b, int n) {
+		for (int i = 0; i < n; i++) a[i] *= b[i];
+	}
+
+	/**
+	 * @brief `a[i] *= c` を行う。
+	 *
+	 * O(N)
+	 */
+	static void scale(mint *a, mint c, int n) {
+		for (int i = 0; i < n; i++) a[i] *= c;
+	}
+
+	/**
+	 * @brief `a[i] += c * b[i]` を行う。
+	 *
+	 * O(N)
+	 */
+	static void axpy(mint *a, mint c, const mint *b, int n) {
+		for (int i = 0; i < n; i++) a[i] += c * b[i];
+	}
+
+	/**
+	 * @brief `a[i] += b[i] * c[i]` を行う。
+	 *
+	 * O(N)
+	 */
+	static void fma(mint *a, const mint *b, const mint *c, int n) {
+		for (int i = 0; i < n; i++) a[i] += b[i] * c[i];
+	}
+
+	/**
+	 * @brief `\sum a[i] b[i]` を求める。 `mint::dot` があればそれを使う。
+	 *
+	 * O(N)
+	 */
+	static mint dot(const mint *a, const mint *b, int n) {
+		if constexpr (requires { mint::dot(a, b, n); }) return mint::dot(a, b, n);
+		mint res = 0;
+		for (int i = 0; i < n; i++) res += a[i] * b[i];
+		return res;
+	}
+};
+
+/**
+ * @brief 32 bit の `static_mint` に対する要素ごとの演算。 AVX2 が使える場合は 8 要素ずつ、 Montgomery 表現のまま計算する。結果は 1 要素ずつ計算した場合と内部表現まで一致する。
+ *
+ * @tparam mod `mod*4` が `uint32_t` に収まるような奇数
+ */
+template<uint32_t mod>
+struct mint_simd<static_mint<mod>> {
+	using mint = static_mint<mod>;
+	static void add(mint *a, const mint *b, int n) {
+		int i = _avx2 ? _add(_raw(a), _raw(b), n) : 0;
+		for (; i < n; i++) a[i] += b[i];
+	}
+	static void sub(mint *a, const mint *b, int n) {
+		int i = _avx2 ? _sub(_raw(a), _raw(b), n) : 0;
+		for (; i < n; i++) a[i] -= b[i];
+	}
+	static void mul(mint *a, const mint *b, int n) {
+		int i = _avx2 ? _mul(_raw(a), _raw(b), n) : 0;
+		for (; i < n; i++) a[i] *= b[i];
+	}
+	static void scale(mint *a, mint c, int n) {
+		int i = _avx2 ? _scale(_raw(a), *_raw(&c), n) : 0;
+		for (; i < n; i++) a[i] *= c;
+	}
+	static void axpy(mint *a, mint c, const mint *b, int n) {
+		int i = _avx2 ? _axpy(_raw(a), *_raw(&c), _raw(b), n) : 0;
+		for (; i < n; i++) a[i] += c * b[i];
+	}
+	static void fma(mint *a, const mint *b, const mint *c, int n) {
+		int i = _avx2 ? _fma(_raw(a), _raw(b), _raw(c), n) : 0;
+		for (; i < n; i++) a[i] += b[i] * c[i];
+	}
+	static mint dot(const mint *a, const mint *b, int n) {
+		mint res = 0;
+		int i = 0;
+		if (_avx2) {
+			// 表現どうしの積の和 s は \sum ab R^2 と合同である。 mod R 未満に落としてから 1 回だけ Montgomery 還元する。
+			__uint128_t s = 0;
+			i = _dot(_raw(a), _raw(b), n, s);
+			uint64_t t = uint64_t(s >> 64) % mod * _r64 + uint64_t(s) % mod;
+			*_raw(&res) = (t + uint64_t(uint32_t(t) * _nninv) * mod) >> 32;
+		}
+		return res + mint::dot(a+i, b+i, n-i);
+	}
+private:
+	static_assert(sizeof(mint) == sizeof(uint32_t) && is_trivially_copyable_v<mint>);
+	constexpr static uint32_t _nninv = []() {
+		uint32_t res = mod;
+		while (mod * res != 1) res *= 2u - mod * res;
+		return -res;
+	}();
+	constexpr static uint64_t _r64 = -uint64_t(mod) % mod;
+	static uint32_t *_raw(mint *a) { return reinterpret_cast<uint32_t *>(a); }
+	static const uint32_t *_raw(const mint *a) { return reinterpret_cast<const uint32_t *>(a); }
+#if defined(__x86_64__) || defined(__i386__)
+	inline static const bool _avx2 = __builtin_cpu_supports("avx2");
+	// 以下はいずれも先頭から 8 要素ずつ処理し、処理した要素数を返す。
+	__attribute__((target("avx2"))) static __m256i _vmul(__m256i x, __m256i y) {
+		// 偶数番目と奇数番目の 32 bit を別々に 64 bit で掛け、 (xy + (xy * -mod^-1 mod 2^32) mod) / 2^32 とする。
+		const __m256i m = _mm256_set1_epi64x(mod), ni = _mm256_set1_epi64x(_nninv);
+		__m256i pe = _mm256_mul_epu32(x, y);
+		__m256i po = _mm256_mul_epu32(_mm256_srli_epi64(x, 32), _mm256_srli_epi64(y, 32));
+		__m256i re = _mm256_srli_epi64(_mm256_add_epi64(pe, _mm256_mul_epu32(_mm256_mul_epu32(pe, ni), m)), 32);
+		__m256i ro = _mm256_add_epi64(po, _mm256_mul_epu32(_mm256_mul_epu32(po, ni), m));
+		return _mm256_blend_epi32(re, ro, 0b10101010);
+	}
+	__attribute__((target("avx2"))) static __m256i _vadd(__m256i x, __m256i y) {
+		const __m256i m2 = _mm256_set1_epi32(mod*2);
+		__m256i s = _mm256_add_epi32(x, y);
+		return _mm256_min_epu32(s, _mm256_sub_epi32(s, m2));
+	}
+	__attribute__((target("avx2"))) static __m256i _vsub(__m256i x, __m256i y) {
+		const __m256i m2 = _mm256_set1_epi32(mod*2);
+		__m256i s = _mm256_sub_epi32(x, y);
+		return _mm256_min_epu32(s, _mm256_add_epi32(s, m2));
+	}
+	__attribute__((target("avx2"))) static __m256i _load(const uint32_t *p) { return _mm256_loadu_si256(reinterpret_cast<const __m256i *>(p)); }
+	__attribute__((target("avx2"))) static void _store(uint32_t *p, __m256i x) { _mm256_storeu_si256(reinterpret_cast<__m256i *>(p), x); }
+	__attribute__((target("avx2"))) static int _add(uint32_t *a, const uint32_t *b, int n) {
+		int i = 0;
+		for (; i+8 <= n; i += 8) _store(a+i, _vadd(_load(a+i), _load(b+i)));
+		return i;
+	}
+	__attribute__((target("avx2"))) static int _sub(uint32_t *a, const uint32_t *b, int n) {
+		int i = 0;
+		for (; i+8 <= n; i += 8) _store(a+i, _vsub(_load(a+i), _load(b+i)));
+		return i;
+	}
+	__attribute__((target("avx2"))) static int _mul(uint32_t *a, const uint32_t *b, int n) {
+		int i = 0;
+		for (; i+8 <= n; i += 8) _store(a+i, _vmul(_load(a+i), _load(b+i)));
+		return i;
+	}
+	__attribute__((target("avx2"))) static int _scale(uint32_t *a, uint32_t c, int n) {
+		__m256i vc = _mm256_set1_epi32(c);
+		int i = 0;
+		for (; i+8 <= n; i += 8) _store(a+i, _vmul(_load(a+i), vc));
+		return i;
+	}
+	__attribute__((target("avx2"))) static int _axpy(uint32_t *a, uint32_t c, const uint32_t *b, int n) {
+		__m256i vc = _mm256_set1_epi32(c);
+		int i = 0;
+		for (; i+8 <= n; i += 8) _store(a+i, _vadd(_load(a+i), _vmul(vc, _load(b+i))));
+		return i;
+	}
+	__attribute__((target("avx2"))) static int _fma(uint32_t *a, const uint32_t *b, const uint32_t *c, int n) {
+		int i = 0;
+		for (; i+8 <= n; i += 8) _store(a+i, _vadd(_load(a+i), _vmul(_load(b+i), _load(c+i))));
+		return i;
+	}
+	__attribute__((target("avx2"))) static int _dot(const uint32_t *a, const uint32_t *b, int n, __uint128_t &s) {
+		// 還元せずに 64 bit の積を上位と下位の 32 bit に分けて足すので、 n < 2^32 であれば溢れない。
+		__m256i lo = _mm256_setzero_si256(), hi = _mm256_setzero_si256();
+		const __m256i mask = _mm256_set1_epi64x(0xffffffff);
+		int i = 0;
+		for (; i+8 <= n; i += 8) {
+			__m256i x = _load(a+i), y = _load(b+i);
+			__m256i pe = _mm256_mul_epu32(x, y);
+			__m256i po = _mm256_mul_epu32(_mm256_srli_epi64(x, 32), _mm256_srli_epi64(y, 32));
+			lo = _mm256_add_epi64(lo, _mm256_add_epi64(_mm256_and_si256(pe, mask), _mm256_and_si256(po, mask)));
+			hi = _mm256_add_epi64(hi, _mm256_add_epi64(_mm256_srli_epi64(pe, 32), _mm256_srli_epi64(po, 32)));
+		}
+		alignas(32) uint64_t tl[4], th[4];
+		_mm256_store_si256(reinterpret_cast<__m256i *>(tl), lo);
+		_mm256_store_si256(reinterpret_cast<__m256i *>(th), hi);
+		s = (__uint128_t(th[0] + th[1] + th[2] + th[3]) << 32) + tl[0] + tl[1] + tl[2] + tl[3];
+		return i;
+	}
+#else
+	constexpr static bool _avx2 = false;
+	static int _add(uint32_t *, const uint32_t *, int) { return 0; }
+	static int _sub(uint32_t *, const uint32_t *, int) { return 0; }
+	static int _mul(uint32_t *, const uint32_t *, int) { return 0; }
+	static int _scale(uint32_t *, uint32_t, int) { return 0; }
+	static int _axpy(uint32_t *, uint32_t, const uint32_t *, int) { return 0; }
+	static int _fma(uint32_t *, const uint32_t *, const uint32_t *, int) { return 0; }
+	static int _dot(const uint32_t *, const uint32_t *, int, __uint128_t &) { return 0; }
+#endif
+};
@@ -8,6 +8,7 @@
 #include <bits/stdc++.h>
 #include "../custom_concepts.hpp"
 #include "../number_theory/is_prime.hpp"
+#include "mint_batch.hpp"
 using namespace std;
 
 /// EXPAND FROM HERE
@@ -114,6 +115,51 @@ struct static_montgomery_mint {
 		}
 		return mint(u);
 	}
+
+	/**
+	 * @brief `a` の各要素の逆元を求める。 `mint_batch::batch_inv` を参照。
+	 *
+	 * O(N + log mod)
+	 * @param a 値の列
+	 * @return 各要素の逆元の列
+	 */
+	static vector<mint> batch_inv(const vector<mint> &a) {
+		return mint_batch<mint>::batch_inv(a);
+	}
+
+	/**
+	 * @brief `\sum a[i] b[i]` を求める。 32 bit の場合は `mint_batch::dot` によって Montgomery 表現どうしの積を足し合わせ、最後に 1 回だけ還元する。
+	 *
+	 * O(N)
+	 * @param a, b 長さ `n` の列の先頭
+	 * @param n 長さ
+	 * @return 内積
+	 */
+	static mint dot(const mint *a, const mint *b, int n) {
+		if constexpr (sizeof(_uint) == 4) {
+			// 各積は 4 mod^2 < 2^62 未満で、和は \sum ab R^2 と合同である。 2^64 = _r2 (mod mod) で mod R 未満に落としてから還元する。
+			return mint_batch<mint>::dot(a, b, n, &mint::_xr, [](__uint128_t s) {
+				mint res;
+				res._xr = res._reduce(_ulong(s >> 64) % mod * _r2 + _ulong(s) % mod);
+				return res;
+			});
+		} else {
+			mint res;
+			for (int i = 0; i < n; i++) res += a[i] * b[i];
+			return res;
+		}
+	}
+
+	/**
+	 * @brief `1, ..., n` の逆元の表を返す。表はスレッド内の呼び出し間で共有される。 `mint_batch::inv_table` を参照。
+	 *
+	 * ならし O(N)
+	 * @param n 上限
+	 * @return `i` 番目が `1/i` である長さ `n+1` 以上の表。 0 番目は 0 である。次に表が伸ばされるまで有効である。
+	 */
+	static const vector<mint> &inv_table(int n) {
+		return mint_batch<mint>::inv_table(_invs, n);
+	}
 	constexpr mint &operator/=(const mint &a) {
 		*this *= a.inv();
 		return *this;
@@ -146,6 +192,7 @@ private:
 		while (mod * res != 1) res *= _uint(2) - mod * res;
 		return res;
 	}();
+	inline static thread_local vector<mint> _invs;
 	_uint _xr;
 	constexpr _uint _reduce(const _ulong &a) const {
 		return (a + _ulong(_uint(a) * _uint(-_ninv)) * mod) >> _sz;
@@ -11,6 +11,7 @@
 #include <bits/stdc++.h>
 #include "../mint/montgomery_mint.hpp"
 #include "../mint/dynamic_montgomery_mint.hpp"
+#include "../mint/dynamic_barrett_mint.hpp"
 #include "pow_mod.hpp"
 using namespace std;
 
@@ -64,7 +65,7 @@ long long discrete_log(int x, int y, unsigned int m) {
 template<gnu_signed_integral _int, gnu_unsigned_integral _uint, gnu_signed_integral _long, gnu_unsigned_integral _ulong, _uint mod>
 requires (sizeof(_int) == sizeof(_uint)) && (sizeof(_long) == sizeof(_ulong)) && (sizeof(_int)*2 == sizeof(_long)) && (mod < _uint(1) << (sizeof(_uint)*8 - 2)) && (mod % 2 == 1)
 long long static_montgomery_mint<_int, _uint, _long, _ulong, mod>::discrete_log(mint x, mint y) {
-	return discrete_log(x.val(), y.val(), mod);
+	return ::discrete_log(x.val(), y.val(), mod);
 }
 
 /**
@@ -83,5 +84,19 @@ long long static_montgomery_mint<_int, _uint, _long, _ulong, mod>::discrete_log(
 template<gnu_signed_integral _int, gnu_unsigned_integral _uint, gnu_signed_integral _long, gnu_unsigned_integral _ulong, int id>
 requires (sizeof(_int) == sizeof(_uint)) && (sizeof(_long) == sizeof(_ulong)) && (sizeof(_int)*2 == sizeof(_long))
 long long dynamic_montgomery_mint<_int, _uint, _long, _ulong, id>::discrete_log(mint x, mint y) {
-	return discrete_log(x.val(), y.val(), mod);
+	return ::discrete_log(x.val(), y.val(), mod);
+}
+
+/**
+ * @brief `mint` の上で `x^n=y` となる最小の `n` を返す。存在しない場合は -1 を返す。
+ *
+ * O(mod^(1/2))
+ * @tparam id 型を区別するための ID 。同じ ID を持つインスタンスは同じ `mod` を持つ。
+ * @param x 底
+ * @param y 真数
+ * @return `mint` の上で `x^n=y` となる最小の `n` または -1
+ */
+template<int id>
+long long dynamic_barrett_mint<id>::discrete_log(mint x, mint y) {
+	return ::discrete_log(x.val(), y.val(), mod);
 }
\ No newline at end of file
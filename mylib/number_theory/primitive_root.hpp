@@ -11,6 +11,7 @@
 #include <bits/stdc++.h>
 #include "../mint/montgomery_mint.hpp"
 #include "../mint/dynamic_montgomery_mint.hpp"
+#include "../mint/dynamic_barrett_mint.hpp"
 #include "factorize.hpp"
 using namespace std;
 
@@ -90,6 +91,39 @@ dynamic_montgomery_mint<_int, _uint, _long, _ulong, id> dynamic_montgomery_mint<
 	}
 }
 
+/**
+ * @brief `mod` の原始根を 1 つ求める。乱択のため、返り値は呼び出しごとに変化しうる。 `mod` が素数である必要がある。
+ *
+ * @tparam id 型を区別するための ID 。同じ ID を持つインスタンスは同じ `mod` を持つ。
+ * @return `mod` の原始根の 1 つ
+ */
+template<int id>
+dynamic_barrett_mint<id> dynamic_barrett_mint<id>::primitive_root() {
+	using mint = dynamic_barrett_mint<id>;
+	if (mod == 2) return 1;
+	unsigned long long x = mod - 1;
+	vector<int> primes;
+	while (!is_prime(x) && x > 1) {
+		int p = find_prime_factor(x);
+		primes.push_back(p);
+		while (x % p == 0) x /= p;
+	}
+	if (x > 1) primes.push_back(x);
+	mt19937 mt(time(nullptr));
+	while (true) {
+		mint g = mt();
+		if (g == 0) continue;
+		bool ok = true;
+		for (auto &y : primes) {
+			if (g.pow((mod-1)/y) == 1) {
+				ok = false;
+				break;
+			}
+		}
+		if (ok) return g;
+	}
+}
+
 /**
  * @brief `n` の原始根を 1 つ求める。乱択のため、返り値は呼び出しごとに変化しうる。 `n` が素数である必要がある。
  *
@@ -0,0 +1,53 @@
+/**
+ * @file sqrt_mod.hpp
+ * @author rii922
+ * @brief 素数を法とする平方根を求める。
+ * @date 2026-10-19
+ */
+
+#include <bits/stdc++.h>
+#include "pow_mod.hpp"
+using namespace std;
+
+/// EXPAND FROM HERE
+
+/**
+ * @brief Tonelli-Shanks 法によって `x^2=a (mod p)` となる `x` を 1 つ求める。存在しない場合は -1 を返す。 `p` が素数である必要がある。
+ *
+ * O(log^2 p)
+ * @param a 平方根を求める数
+ * @param p 法
+ * @return `x^2=a (mod p)` となる `0 <= x < p` または -1
+ */
+long long sqrt_mod(long long a, long long p) {
+	a %= p;
+	if (a < 0) a += p;
+	if (a == 0 || p == 2) return a;
+	if (pow_mod<long long, __int128_t>(a, (p-1)/2, p) != 1) return -1;
+	long long q = p-1;
+	int s = 0;
+	while (q % 2 == 0) {
+		q /= 2;
+		s++;
+	}
+	long long z = 2;
+	while (pow_mod<long long, __int128_t>(z, (p-1)/2, p) != p-1) z++;
+	long long c = pow_mod<long long, __int128_t>(z, q, p);
+	long long t = pow_mod<long long, __int128_t>(a, q, p);
+	long long r = pow_mod<long long, __int128_t>(a, (q+1)/2, p);
+	while (t != 1) {
+		int i = 0;
+		long long u = t;
+		while (u != 1) {
+			u = (__int128_t)u*u%p;
+			i++;
+		}
+		long long b = c;
+		for (int j = 0; j < s-i-1; j++) b = (__int128_t)b*b%p;
+		s = i;
+		c = (__int128_t)b*b%p;
+		t = (__int128_t)t*c%p;
+		r = (__int128_t)r*b%p;
+	}
+	return r;
+}
@@ -0,0 +1,103 @@
+/**
+ * @file berlekamp_massey.hpp
+ * @author rii922
+ * @brief Berlekamp–Massey 法による最短の線形漸化式の復元
+ * @date 2026-10-19
+ */
+
+#include <bits/stdc++.h>
+#include "fps.hpp"
+#include "half_gcd.hpp"
+#include "bostan_mori.hpp"
+using namespace std;
+
+/// EXPAND FROM HERE
+
+/**
+ * @brief 数列 `a` を生成する最短の線形漸化式を Berlekamp–Massey 法によって求める。 `static_mint` や `dynamic_mint` などの体であれば使える。
+ *
+ * O(N^2)
+ * @tparam mint 体をなす整数型
+ * @param a 数列
+ * @return 長さ `L+1` の `c` で、 `c[0] = 1` かつ `i >= L` で `\sum_j c[j] a[i-j] = 0` を満たすもの。特性多項式を反転したものであり、母関数の分母となる。
+ */
+template<class mint>
+vector<mint> berlekamp_massey(const vector<mint> &a) {
+	int n = a.size(), l = 0, m = 0;
+	vector<mint> c(n+1, 0), b(n+1, 0), t;
+	c[0] = b[0] = 1;
+	mint x = 1;
+	for (int i = 0; i < n; i++) {
+		m++;
+		mint d = a[i];
+		for (int j = 1; j <= l; j++) d += c[j] * a[i-j];
+		if (d == 0) continue;
+		t = c;
+		mint coef = d / x;
+		for (int j = m; j <= n; j++) c[j] -= coef * b[j-m];
+		if (l*2 > i) continue;
+		l = i + 1 - l;
+		b = t;
+		x = d;
+		m = 0;
+	}
+	c.resize(l+1);
+	return c;
+}
+
+/**
+ * @brief 数列 `a` を生成する最短の線形漸化式を求める。長い数列では、 `a` を反転した多項式と `x^N` に half-GCD による互除法を適用し、余りの次数が初めて途中の係数の次数を下回る段を求める。短い数列では `O(N^2)` の Berlekamp–Massey 法を使う。
+ *
+ * O(N log^2 N)
+ * @tparam fps 形式的冪級数を扱うクラス
+ * @param a 数列
+ * @return 項数 `L+1` の多項式 `Q` で、 `Q(0) = 1` かつ `a` の母関数に `Q` を掛けると `L` 次以上の項が `N` 次未満で消えるもの
+ */
+template<class fps> requires same_as<fps, typename fps::fps>
+fps berlekamp_massey(const fps &a) {
+	using mint = typename fps::mint;
+	using hg = half_gcd<fps>;
+	constexpr int naive_threshold = 2048;
+	int n = a.size();
+	if (n <= naive_threshold) {
+		vector<mint> v(n);
+		for (int i = 0; i < n; i++) v[i] = a[i];
+		return fps(berlekamp_massey(v));
+	}
+	// C(x) B(x) = R(x) (mod x^n), deg R < deg C となる最小次数の C が特性多項式である。
+	fps xn(n+1, 0), b(n);
+	xn[n] = 1;
+	for (int i = 0; i < n; i++) b[n-1-i] = a[i];
+	b = b.pre(max(hg::deg(b), 0) + 1);
+	if (hg::deg(b) < 0) return fps{1};
+	// hgcd の後、条件を満たすのは次の段かその次の段である。
+	typename hg::matrix m = hg::hgcd(xn, b);
+	pair<fps, fps> r = hg::apply(m, xn, b);
+	fps t = m[3];
+	if (hg::deg(r.second) >= hg::deg(t)) {
+		fps q = r.first.div(r.second);
+		t = m[1] - q * m[3];
+	}
+	int l = hg::deg(t);
+	mint il = t[l].inv();
+	fps res(l+1);
+	for (int i = 0; i <= l; i++) res[i] = t[l-i] * il;
+	return res;
+}
+
+/**
+ * @brief 数列 `a` を生成する最短の線形漸化式を Berlekamp–Massey 法で求め、その第 `k` 項を Bostan–Mori 法によって求める。 `a` は漸化式の長さの 2 倍以上の項を持つ必要がある。
+ *
+ * O(N log^2 N + L log L log K)
+ * @tparam fps 形式的冪級数を扱うクラス
+ * @param a 数列
+ * @param k 求める項の添字
+ * @return 第 `k` 項
+ */
+template<class fps> requires same_as<fps, typename fps::fps>
+typename fps::mint nth_term(const fps &a, long long k) {
+	if (k < a.size()) return a[k];
+	fps q = berlekamp_massey(a);
+	int l = q.size() - 1;
+	return bostan_mori((a.pre(l) * q).pre(l), q, k);
+}
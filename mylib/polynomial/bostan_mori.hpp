@@ -0,0 +1,110 @@
+/**
+ * @file bostan_mori.hpp
+ * @author rii922
+ * @brief Bostan–Mori 法による有理式の係数および線形漸化式の第 N 項
+ * @date 2026-10-19
+ */
+
+#include <bits/stdc++.h>
+#include "fps.hpp"
+using namespace std;
+
+/// EXPAND FROM HERE
+
+/**
+ * @brief `[x^n] P(x)/Q(x)` を Bostan–Mori 法によって求める。 `P(x)/Q(x) = P(x)Q(-x)/Q(x)Q(-x)` の分母が `x^2` の多項式であることを使い、 `n` を半分にしていく。 NTT が使える場合、 `P` と `Q` を長さ `2L` の変換のまま保つ。 `Q(-x)` の変換は隣り合う組の入れ替えで、偶奇への分解は組ごとの計算で得られ、次の段の変換の後半は長さ `L` の変換で求めるため、 1 段あたり長さ `L` の変換 4 回で済む。
+ *
+ * O(K log K log N)
+ * @tparam fps 形式的冪級数を扱うクラス
+ * @param p 分子
+ * @param q 分母。定数項が 0 であってはいけない。
+ * @param n 求める係数の次数
+ * @return `[x^n] P(x)/Q(x)`
+ */
+template<class fps>
+typename fps::mint bostan_mori(fps p, fps q, long long n) {
+	using mint = typename fps::mint;
+	assert(!q.empty() && q[0] != 0 && n >= 0);
+	if (p.empty()) return 0;
+	if constexpr (fps::ntt_friendly) {
+		int l = 1;
+		while (l < max(p.size(), q.size())) l <<= 1;
+		// x と x^(2l-1) の変換から、長さ 2l の変換の各項が表す点とその逆数を得る。
+		vector<mint> w(l<<1, 0), iw(l<<1, 0), a(l<<1, 0), b(l<<1, 0);
+		w[1] = 1;
+		iw[(l<<1)-1] = 1;
+		fps::ntt(w);
+		fps::ntt(iw);
+		for (int i = 0; i < p.size(); i++) a[i] = p[i];
+		for (int i = 0; i < q.size(); i++) b[i] = q[i];
+		fps::ntt(a);
+		fps::ntt(b);
+		// 後半 l 項の点は前半 l 項の点の w[l] 倍である。
+		vector<mint> zp(l);
+		zp[0] = 1;
+		for (int i = 1; i < l; i++) zp[i] = zp[i-1] * w[l];
+		mint i2 = mint(2).inv();
+		vector<mint> u(l), v(l);
+		while (n > 0) {
+			for (int i = 0; i < l; i++) {
+				mint x = a[i<<1] * b[i<<1|1], y = a[i<<1|1] * b[i<<1];
+				u[i] = (n & 1) ? (x - y) * iw[i<<1] * i2 : (x + y) * i2;
+				v[i] = b[i<<1] * b[i<<1|1];
+			}
+			n >>= 1;
+			copy(u.begin(), u.end(), a.begin());
+			copy(v.begin(), v.end(), b.begin());
+			fps::intt(u);
+			fps::intt(v);
+			for (int i = 0; i < l; i++) {
+				u[i] *= zp[i];
+				v[i] *= zp[i];
+			}
+			fps::ntt(u);
+			fps::ntt(v);
+			copy(u.begin(), u.end(), a.begin()+l);
+			copy(v.begin(), v.end(), b.begin()+l);
+		}
+		// 定数項は全ての点での値の平均である。
+		mint sa = 0, sb = 0;
+		for (int i = 0; i < (l<<1); i++) {
+			sa += a[i];
+			sb += b[i];
+		}
+		return sa / sb;
+	} else {
+		while (n > 0) {
+			fps mq = q;
+			for (int i = 1; i < mq.size(); i += 2) mq[i] = -mq[i];
+			fps u = p * mq, v = q * mq;
+			p = fps((u.size() + 1 - (n & 1)) / 2);
+			for (int i = 0; i < p.size(); i++) p[i] = u[i*2+(n&1)];
+			q = fps((v.size() + 1) / 2);
+			for (int i = 0; i < q.size(); i++) q[i] = v[i*2];
+			n >>= 1;
+			if (p.empty()) return 0;
+		}
+		return p[0] / q[0];
+	}
+}
+
+/**
+ * @brief `a[i] = c[0] a[i-1] + c[1] a[i-2] + ... + c[d-1] a[i-d]` を満たす数列の第 `n` 項を Bostan–Mori 法によって求める。
+ *
+ * O(D log D log N)
+ * @tparam fps 形式的冪級数を扱うクラス
+ * @param a 初めの `d` 項
+ * @param c 漸化式の係数。 `a.size() == c.size()` である必要がある。
+ * @param n 求める項の添字
+ * @return 第 `n` 項
+ */
+template<class fps>
+typename fps::mint linear_recurrence_nth(const fps &a, const fps &c, long long n) {
+	assert(a.size() == c.size());
+	int d = c.size();
+	if (n < d) return a[n];
+	fps q(d+1);
+	q[0] = 1;
+	for (int i = 0; i < d; i++) q[i+1] = -c[i];
+	return bostan_mori((a * q).pre(d), q, n);
+}
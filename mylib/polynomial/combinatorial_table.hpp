@@ -0,0 +1,199 @@
+/**
+ * @file combinatorial_table.hpp
+ * @author rii922
+ * @brief 形式的冪級数による組合せ数の表
+ * @date 2026-10-19
+ */
+
+#include <bits/stdc++.h>
+#include "fps.hpp"
+using namespace std;
+
+/// EXPAND FROM HERE
+
+/**
+ * @brief 形式的冪級数の `exp` 、 `inv` 、 `pow` および畳み込みによって、 Bernoulli 数、 Stirling 数、分割数、 Bell 数の表を作る。 `mod` が求める項数より大きい素数である必要がある。階乗の表は `fps::fact_table` を使う。
+ *
+ * @tparam fps 形式的冪級数を扱うクラス
+ */
+template<class fps>
+struct combinatorial_table {
+	using mint = typename fps::mint;
+
+	/**
+	 * @brief Bernoulli 数 `B_0, ..., B_(n-1)` を、指数型母関数 `x / (e^x - 1)` から求める。 `B_1 = -1/2` である。
+	 *
+	 * O(N log N)
+	 * @param n 項数
+	 * @return Bernoulli 数
+	 */
+	static fps bernoulli(int n) {
+		if (n == 0) return fps(0);
+		const vector<mint> &fact = fps::fact_table(n+1), &ifact = fps::ifact_table(n+1);
+		fps f(n);
+		for (int i = 0; i < n; i++) f[i] = ifact[i+1];
+		f = f.inv();
+		for (int i = 0; i < n; i++) f[i] *= fact[i];
+		return f;
+	}
+
+	/**
+	 * @brief 分割数 `p(0), ..., p(n-1)` を、五角数定理による `\prod (1 - x^k)` の逆数として求める。
+	 *
+	 * O(N log N)
+	 * @param n 項数
+	 * @return 分割数
+	 */
+	static fps partition(int n) {
+		if (n == 0) return fps(0);
+		fps f(n, 0);
+		f[0] = 1;
+		for (long long k = 1; k*(3*k-1)/2 < n; k++) {
+			mint s = k & 1 ? -1 : 1;
+			f[k*(3*k-1)/2] += s;
+			if (k*(3*k+1)/2 < n) f[k*(3*k+1)/2] += s;
+		}
+		return f.inv();
+	}
+
+	/**
+	 * @brief Bell 数 `B_0, ..., B_(n-1)` を、指数型母関数 `exp(e^x - 1)` から求める。
+	 *
+	 * O(N log N)
+	 * @param n 項数
+	 * @return Bell 数
+	 */
+	static fps bell(int n) {
+		if (n == 0) return fps(0);
+		const vector<mint> &fact = fps::fact_table(n), &ifact = fps::ifact_table(n);
+		fps f(n, 0);
+		for (int i = 1; i < n; i++) f[i] = ifact[i];
+		f = f.exp();
+		for (int i = 0; i < n; i++) f[i] *= fact[i];
+		return f;
+	}
+
+	/**
+	 * @brief 符号付き第 1 種 Stirling 数 `s(n, 0), ..., s(n, n)` を、 `x (x-1) ... (x-n+1)` を `taylor_shift` で倍々に伸ばして求める。
+	 *
+	 * O(N log N)
+	 * @param n 非負整数
+	 * @return 項数 `n+1` の列
+	 */
+	static fps stirling1_row(int n) {
+		fps f = {1};
+		int m = 0;
+		for (int b = n ? __lg(n) : -1; b >= 0; b--) {
+			// f_(2m)(x) = f_m(x) f_m(x-m)
+			if (m > 0) {
+				f *= f.taylor_shift(-m);
+				m *= 2;
+			}
+			if (n >> b & 1) {
+				fps g(m+2, 0);
+				for (int i = 0; i <= m; i++) {
+					g[i+1] += f[i];
+					g[i] -= f[i] * m;
+				}
+				f = move(g);
+				m++;
+			}
+		}
+		return f.pre(n+1);
+	}
+
+	/**
+	 * @brief 第 2 種 Stirling 数 `S(n, 0), ..., S(n, n)` を、 `S(n, k) = \sum_i (-1)^(k-i) i^n / (i! (k-i)!)` を 1 回の畳み込みにして求める。
+	 *
+	 * O(N log N)
+	 * @param n 非負整数
+	 * @return 項数 `n+1` の列
+	 */
+	static fps stirling2_row(int n) {
+		const vector<mint> &ifact = fps::ifact_table(n+1);
+		fps a(n+1), b(n+1);
+		for (int i = 0; i <= n; i++) {
+			a[i] = mint(i).pow(n) * ifact[i];
+			b[i] = i & 1 ? -ifact[i] : ifact[i];
+		}
+		return (a * b).pre(n+1);
+	}
+
+	/**
+	 * @brief 符号付き第 1 種 Stirling 数 `s(0, k), ..., s(n-1, k)` を、指数型母関数 `log(1+x)^k / k!` から求める。
+	 *
+	 * O(N log N)
+	 * @param k 非負整数
+	 * @param n 項数
+	 * @return 項数 `n` の列
+	 */
+	static fps stirling1_column(int k, int n) {
+		if (n <= k) return fps(n, 0);
+		const vector<mint> &fact = fps::fact_table(n+1), &ifact = fps::ifact_table(n+1);
+		// log(1+x) / x = \sum (-1)^i x^i / (i+1)
+		fps f(n-k);
+		for (int i = 0; i < n-k; i++) {
+			f[i] = ifact[i+1] * fact[i];
+			if (i & 1) f[i] = -f[i];
+		}
+		return _column(f, k, n);
+	}
+
+	/**
+	 * @brief 第 2 種 Stirling 数 `S(0, k), ..., S(n-1, k)` を、指数型母関数 `(e^x - 1)^k / k!` から求める。
+	 *
+	 * O(N log N)
+	 * @param k 非負整数
+	 * @param n 項数
+	 * @return 項数 `n` の列
+	 */
+	static fps stirling2_column(int k, int n) {
+		if (n <= k) return fps(n, 0);
+		const vector<mint> &ifact = fps::ifact_table(n+1);
+		// (e^x - 1) / x = \sum x^i / (i+1)!
+		fps f(n-k);
+		for (int i = 0; i < n-k; i++) f[i] = ifact[i+1];
+		return _column(f, k, n);
+	}
+
+	/**
+	 * @brief `path` に保存された表を読み込む。ファイルが無いか、 `mod` が異なるか、項数が `n` 未満の場合は `build(n)` で作り、 `path` に保存する。ファイルには `mod` 、項数、各項の値がそのまま並ぶ。
+	 *
+	 * O(N) (読み込める場合)
+	 * @param path ファイルのパス
+	 * @param n 項数
+	 * @param build 項数を受け取り、表を返す関数
+	 * @return 先頭 `n` 項
+	 */
+	template<class F>
+	static fps cached(const string &path, int n, F build) {
+		uint64_t hd[2];
+		ifstream in(path, ios::binary);
+		if (in.read(reinterpret_cast<char *>(hd), sizeof(hd)) && hd[0] == mint::get_mod() && hd[1] >= n) {
+			vector<uint64_t> buf(n);
+			if (in.read(reinterpret_cast<char *>(buf.data()), sizeof(uint64_t) * n)) {
+				fps res(n);
+				for (int i = 0; i < n; i++) res[i] = buf[i];
+				return res;
+			}
+		}
+		fps res = build(n);
+		hd[0] = mint::get_mod();
+		hd[1] = res.size();
+		vector<uint64_t> buf(res.size());
+		for (int i = 0; i < res.size(); i++) buf[i] = res[i].val();
+		ofstream out(path, ios::binary | ios::trunc);
+		out.write(reinterpret_cast<const char *>(hd), sizeof(hd));
+		out.write(reinterpret_cast<const char *>(buf.data()), sizeof(uint64_t) * buf.size());
+		return res;
+	}
+private:
+	static fps _column(const fps &f, int k, int n) {
+		// x^k f^k / k! の係数に i! を掛ける。
+		fps g = f.pow(k);
+		const vector<mint> &fact = fps::fact_table(n), &ifact = fps::ifact_table(n);
+		fps res(n, 0);
+		for (int i = k; i < n; i++) res[i] = g[i-k] * fact[i] * ifact[k];
+		return res;
+	}
+};
@@ -14,7 +14,9 @@
 #include <bits/stdc++.h>
 #include "../custom_concepts.hpp"
 #include "../mint/montgomery_mint.hpp"
+#include "../mint/mint_simd.hpp"
 #include "../convolution/convolution.hpp"
+#include "../number_theory/sqrt_mod.hpp"
 using namespace std;
 
 /// EXPAND FROM HERE
@@ -25,16 +27,17 @@ using namespace std;
  * @tparam _uint `mod*4` を表現可能な符号無し整数型
  * @tparam convolution `operator()` で `mod` を法とした畳み込みを行うクラス
  * @tparam static_mint 自動で剰余を取る整数型
- * @tparam mod 法
+ * @tparam _mod 法
  */
-template<gnu_unsigned_integral _uint, template<_uint mod> class convolution, template<_uint mod> class static_mint, uint32_t mod>
+template<gnu_unsigned_integral _uint, template<_uint mod> class convolution, template<_uint mod> class static_mint, _uint _mod>
 struct fps_base {
-	using fps = fps_base<_uint, convolution, static_mint, mod>;
-	using mint = static_mint<mod>;
+	using fps = fps_base<_uint, convolution, static_mint, _mod>;
+	using mint = static_mint<_mod>;
 	fps_base(int n) : _v(n, 0) {}
 	fps_base(int n, mint &x) : _v(n, x) {}
 	fps_base(int n, mint &&x) : _v(n, x) {}
 	fps_base(const vector<mint> &v) : _v(v) {}
+	fps_base(vector<mint> &&v) : _v(move(v)) {}
 	fps_base(initializer_list<mint> init) : _v(init) {}
 
 	/**
@@ -73,14 +76,18 @@ struct fps_base {
 	fps operator+() const {
 		return fps(*this);
 	}
-	fps operator-() const {
+	fps operator-() const & {
 		fps res(_v.size());
 		for (int i = 0; i < _v.size(); i++) res[i] = -_v[i];
 		return res;
 	}
+	fps operator-() && {
+		for (int i = 0; i < _v.size(); i++) _v[i] = -_v[i];
+		return move(*this);
+	}
 	fps &operator+=(const fps &a) {
 		if (_v.size() < a.size()) _v.resize(a.size());
-		for (int i = 0; i < _v.size(); i++) _v[i] += a[i];
+		mint_simd<mint>::add(_v.data(), a._v.data(), a.size());
 		return *this;
 	}
 	fps &operator+=(const mint &a) {
@@ -90,7 +97,7 @@ struct fps_base {
 	}
 	fps &operator-=(const fps &a) {
 		if (_v.size() < a.size()) _v.resize(a.size());
-		for (int i = 0; i < a.size(); i++) _v[i] -= a[i];
+		mint_simd<mint>::sub(_v.data(), a._v.data(), a.size());
 		return *this;
 	}
 	fps &operator-=(const mint &a) {
@@ -103,7 +110,7 @@ struct fps_base {
 		return *this;
 	}
 	fps &operator*=(const mint &a) {
-		for (int i = 0; i < _v.size(); i++) _v[i] *= a;
+		mint_simd<mint>::scale(_v.data(), a, _v.size());
 		return *this;
 	}
 	fps &operator<<=(int sz) {
@@ -120,36 +127,94 @@ struct fps_base {
 	fps &operator+=(const long long a) { return *this += mint(a); }
 	fps &operator-=(const long long a) { return *this -= mint(a); }
 	fps &operator*=(const long long a) { return *this *= mint(a); }
-	fps operator+(const fps &a) const { return fps(*this) += a; }
-	fps operator+(const mint &a) const { return fps(*this) += a; }
-	fps operator+(const long long a) const { return fps(*this) += mint(a); }
-	fps operator-(const fps &a) const { return fps(*this) -= a; }
-	fps operator-(const mint &a) const { return fps(*this) -= a; }
-	fps operator-(const long long a) const { return fps(*this) -= mint(a); }
+	// 右辺値の被演算子はその領域を結果に使い回す。
+	friend fps operator+(fps a, const fps &b) { a += b; return a; }
+	friend fps operator+(const fps &a, fps &&b) { b += a; return move(b); }
+	friend fps operator+(fps a, const mint &b) { a += b; return a; }
+	friend fps operator+(fps a, const long long b) { a += mint(b); return a; }
+	friend fps operator+(const mint &a, fps b) { b += a; return b; }
+	friend fps operator+(const long long a, fps b) { b += mint(a); return b; }
+	friend fps operator-(fps a, const fps &b) { a -= b; return a; }
+	friend fps operator-(const fps &a, fps &&b) { b = -move(b); b += a; return move(b); }
+	friend fps operator-(fps a, const mint &b) { a -= b; return a; }
+	friend fps operator-(fps a, const long long b) { a -= mint(b); return a; }
+	friend fps operator-(const mint &a, fps b) { b = -move(b); b += a; return b; }
+	friend fps operator-(const long long a, fps b) { b = -move(b); b += mint(a); return b; }
 	fps operator*(const fps &a) const { return fps(*this) *= a; }
-	fps operator*(const mint &a) const { return fps(*this) *= a; }
-	fps operator*(const long long a) const { return fps(*this) *= mint(a); }
-	friend fps operator+(const mint a, const fps b) { return b + a; }
-	friend fps operator-(const mint a, const fps b) { return -b + a; }
-	friend fps operator*(const mint a, const fps b) { return b * a; }
+	friend fps operator*(fps a, const mint &b) { a *= b; return a; }
+	friend fps operator*(fps a, const long long b) { a *= mint(b); return a; }
+	friend fps operator*(const mint &a, fps b) { b *= a; return b; }
+	friend fps operator*(const long long a, fps b) { b *= mint(a); return b; }
 	fps operator<<(int sz) const { return fps(*this) <<= sz; }
 	fps operator>>(int sz) const { return fps(*this) >>= sz; }
 
 	/**
-	 * @brief 先頭 `sz` 項を返す。
+	 * @brief `convolution` が NTT を提供し、変換領域での計算ができるかどうか。
+	 */
+	constexpr static bool ntt_friendly = requires(vector<mint> &v) {
+		convolution<_mod>().ntt(v);
+		convolution<_mod>().intt(v);
+	};
+
+	/**
+	 * @brief 長さが 2 冪の `v` をその場で NTT によって変換する。結果はビット反転順に並ぶ。
+	 *
+	 * O(N log N)
+	 * @param v 長さが 2 冪の `vector`
+	 */
+	static void ntt(vector<mint> &v) requires ntt_friendly { _conv.ntt(v); }
+
+	/**
+	 * @brief `ntt` の逆変換をその場で行う。
+	 *
+	 * O(N log N)
+	 * @param v 長さが 2 冪の `vector`
+	 */
+	static void intt(vector<mint> &v) requires ntt_friendly { _conv.intt(v); }
+
+	/**
+	 * @brief `0!, ..., (n-1)!` の表を返す。表はスレッド内で `taylor_shift` などと共有され、必要に応じて倍々に伸ばされる。 `mod` が `n` 以上の素数である必要がある。
+	 *
+	 * ならし O(N)
+	 * @param n 項数
+	 * @return `i` 番目が `i!` である長さ `n` 以上の表。次に表が伸ばされるまで有効である。
+	 */
+	static const vector<mint> &fact_table(int n) {
+		_prepare_fact(n);
+		return _fact;
+	}
+
+	/**
+	 * @brief `1/0!, ..., 1/(n-1)!` の表を返す。表は `fact_table` と同時に伸ばされる。 `mod` が `n` 以上の素数である必要がある。
+	 *
+	 * ならし O(N)
+	 * @param n 項数
+	 * @return `i` 番目が `1/i!` である長さ `n` 以上の表。次に表が伸ばされるまで有効である。
+	 */
+	static const vector<mint> &ifact_table(int n) {
+		_prepare_fact(n);
+		return _ifact;
+	}
+
+	/**
+	 * @brief 先頭 `sz` 項を返す。右辺値に対しては領域をそのまま使う。
 	 *
 	 * @param sz 項数
 	 * @return 先頭 `sz` 項
 	 */
-	fps pre(int sz) const {
+	fps pre(int sz) const & {
 		fps res(sz, 0);
 		int m = min((int)_v.size(), sz);
 		for (int i = 0; i < m; i++) res[i] = _v[i];
 		return res;
 	}
+	fps pre(int sz) && {
+		_v.resize(sz);
+		return move(*this);
+	}
 
 	/**
-	 * @brief `fg = 1` となる逆数 `g` をダブリングによって求める。定数項が 0 であってはいけない。
+	 * @brief `fg = 1` となる逆数 `g` をダブリングによって求める。定数項が 0 であってはいけない。 NTT が使える場合、変換を使い回して 1 段あたり長さ `2i` の変換 5 回で計算する。非零項が少ない場合は `sparse_inv` を使う。
 	 *
 	 * O(N log N)
 	 * @param deg 求める項数。指定しない場合、 `size()` が使われる。
@@ -158,12 +223,36 @@ struct fps_base {
 	fps inv(int deg=-1) const {
 		assert(!_v.empty() && _v[0] != 0);
 		if (deg == -1) deg = _v.size();
-		fps res = {_v[0].inv()};
-		for (int i = 1; i < deg; i <<= 1) {
-			res = (res + res - res * res * pre(i<<1)).pre(i<<1);
+		vector<pair<int, mint>> sp;
+		if (_sparse_terms(deg, sp)) return sparse_inv(sp, deg);
+		if constexpr (ntt_friendly) {
+			vector<mint> res = {_v[0].inv()};
+			res.reserve(deg);
+			for (int i = 1; i < deg; i <<= 1) {
+				vector<mint> f(i<<1, 0), g(i<<1, 0);
+				int m = min((int)_v.size(), i<<1);
+				for (int j = 0; j < m; j++) f[j] = _v[j];
+				for (int j = 0; j < i; j++) g[j] = res[j];
+				_conv.ntt(f);
+				_conv.ntt(g);
+				mint_simd<mint>::mul(f.data(), g.data(), i<<1);
+				_conv.intt(f);
+				fill(f.begin(), f.begin()+i, 0);
+				_conv.ntt(f);
+				mint_simd<mint>::mul(f.data(), g.data(), i<<1);
+				_conv.intt(f);
+				for (int j = i; j < (i<<1); j++) res.push_back(-f[j]);
+			}
+			res.resize(deg);
+			return fps(move(res));
+		} else {
+			fps res = {_v[0].inv()};
+			for (int i = 1; i < deg; i <<= 1) {
+				res = (res + res - res * res * pre(i<<1)).pre(i<<1);
+			}
+			res = res.pre(deg);
+			return res;
 		}
-		res = res.pre(deg);
-		return res;
 	}
 	fps &operator/=(const fps &a) {
 		*this *= a.inv(max((int)_v.size(), a.size()));
@@ -175,10 +264,81 @@ struct fps_base {
 		return *this;
 	}
 	fps operator/(const fps &a) const { return fps(*this) /= a; }
-	fps operator/(const mint &a) const { return fps(*this) /= a; }
-	fps operator/(const long long a) const { return fps(*this) /= mint(a); }
+	friend fps operator/(fps a, const mint &b) { a /= b; return a; }
+	friend fps operator/(fps a, const long long b) { a /= mint(b); return a; }
 	friend fps operator/(const mint a, const fps b) { return b.inv() * a; }
 
+	/**
+	 * @brief 多項式として `b` で割った商と余りを求める。 `b` は 0 であってはいけない。商は反転した `b` の逆数を使って求め、余りは 1 回の掛け算で求める。 `b` の次数または商の次数が小さい場合は筆算を行う。
+	 *
+	 * O(N log N)
+	 * @param b 割る多項式
+	 * @return 商と余りの組。商の項数は `max(0, deg(*this)-deg(b)+1)` 、余りの項数は `deg(b)` である。
+	 */
+	pair<fps, fps> divmod(const fps &b) const {
+		int n = _deg() + 1;
+		int m = b._deg();
+		assert(m >= 0);
+		if (n <= m) return {fps(0), pre(m)};
+		int k = n - m;
+		if (m <= _naive_threshold || k <= _naive_threshold) {
+			vector<mint> r(_v.begin(), _v.begin()+n), q(k);
+			mint ib = b[m].inv();
+			for (int i = k-1; i >= 0; i--) {
+				q[i] = r[i+m] * ib;
+				for (int j = 0; j <= m; j++) r[i+j] -= q[i] * b[j];
+			}
+			r.resize(m);
+			return {fps(move(q)), fps(move(r))};
+		}
+		fps q = _div(b, n, m);
+		if constexpr (ntt_friendly) {
+			// 余りの次数が m 未満であることから、長さ m 以上の巡回畳み込みで下位 m 項を復元できる。
+			int l = 1;
+			while (l < m) l <<= 1;
+			vector<mint> bc(l, 0), qc(l, 0);
+			for (int i = 0; i <= m; i++) bc[i%l] += b[i];
+			for (int i = 0; i < k; i++) qc[i%l] += q[i];
+			_conv.ntt(bc);
+			_conv.ntt(qc);
+			mint_simd<mint>::mul(bc.data(), qc.data(), l);
+			_conv.intt(bc);
+			vector<mint> r(m);
+			for (int i = 0; i < m; i++) r[i] = _v[i] - bc[i];
+			for (int i = l; i < n; i++) if (i%l < m) r[i%l] += _v[i];
+			return {q, fps(move(r))};
+		} else {
+			return {q, (*this - b * q).pre(m)};
+		}
+	}
+
+	/**
+	 * @brief 多項式として `b` で割った商を求める。 `b` は 0 であってはいけない。
+	 *
+	 * O(N log N)
+	 * @param b 割る多項式
+	 * @return 項数 `max(0, deg(*this)-deg(b)+1)` の商
+	 */
+	fps div(const fps &b) const {
+		int n = _deg() + 1;
+		int m = b._deg();
+		assert(m >= 0);
+		if (n <= m) return fps(0);
+		if (m <= _naive_threshold || n - m <= _naive_threshold) return divmod(b).first;
+		return _div(b, n, m);
+	}
+
+	/**
+	 * @brief 多項式として `b` で割った余りを求める。 `b` は 0 であってはいけない。
+	 *
+	 * O(N log N)
+	 * @param b 割る多項式
+	 * @return 項数 `deg(b)` の余り
+	 */
+	fps mod(const fps &b) const {
+		return divmod(b).second;
+	}
+
 	/**
 	 * @brief 形式微分された形式的冪級数を求める。
 	 *
@@ -200,12 +360,13 @@ struct fps_base {
 	fps integral() const {
 		fps res(_v.size()+1);
 		res[0] = 0;
-		for (int i = 0; i < _v.size(); i++) res[i+1] = _v[i] / (i + 1);
+		const vector<mint> &iv = mint::inv_table(_v.size());
+		for (int i = 0; i < _v.size(); i++) res[i+1] = _v[i] * iv[i+1];
 		return res;
 	}
 
 	/**
-	 * @brief 対数 `log f` を返す。定数項が 1 である必要がある。
+	 * @brief 対数 `log f` を返す。定数項が 1 である必要がある。非零項が少ない場合は `sparse_log` を使う。
 	 *
 	 * O(N log N)
 	 * @param deg 求める項数。指定しない場合、 `size()` が使われる。
@@ -214,11 +375,13 @@ struct fps_base {
 	fps log(int deg=-1) const {
 		assert(!_v.empty() && _v[0] == 1);
 		if (deg == -1) deg = _v.size();
+		vector<pair<int, mint>> sp;
+		if (_sparse_terms(deg, sp)) return sparse_log(sp, deg);
 		return (diff() / pre(deg)).pre(deg-1).integral();
 	}
 
 	/**
-	 * @brief 指数 `exp f` を Newton 法によって求める。定数項が 0 である必要がある。
+	 * @brief 指数 `exp f` を Newton 法によって求める。定数項が 0 である必要がある。途中の `exp f` の逆数も同時に Newton 法で更新し、 `log` の再計算を避ける。非零項が少ない場合は `sparse_exp` を使う。
 	 *
 	 * O(N log N)
 	 * @param deg 求める項数。指定しない場合、 `size()` が使われる。
@@ -227,16 +390,73 @@ struct fps_base {
 	fps exp(int deg=-1) const {
 		assert(!_v.empty() && _v[0] == 0);
 		if (deg == -1) deg = _v.size();
-		fps res = {1};
-		for (int i = 1; i < deg; i <<= 1) {
-			res = (res * (pre(i<<1) + 1 - res.log(i<<1))).pre(i<<1);
+		vector<pair<int, mint>> sp;
+		if (_sparse_terms(deg, sp)) return sparse_exp(sp, deg);
+		if (deg <= 2) {
+			fps res = pre(deg);
+			if (deg > 0) res[0] = 1;
+			return res;
+		}
+		if constexpr (ntt_friendly) {
+			// b = exp f mod x^i, c = 1/b mod x^(i/2), zc = NTT(c) (長さ i)
+			vector<mint> b = {1, _v.size() > 1 ? _v[1] : 0}, c = {1}, zc = {1, 1};
+			b.reserve(deg<<1);
+			c.reserve(deg);
+			const vector<mint> &iv = mint::inv_table(deg<<1);
+			for (int i = 2; i < deg; i <<= 1) {
+				vector<mint> y = b;
+				y.resize(i<<1);
+				_conv.ntt(y);
+				vector<mint> z(i);
+				for (int j = 0; j < i; j++) z[j] = y[j] * zc[j];
+				_conv.intt(z);
+				fill(z.begin(), z.begin()+(i>>1), 0);
+				_conv.ntt(z);
+				for (int j = 0; j < i; j++) z[j] *= -zc[j];
+				_conv.intt(z);
+				c.insert(c.end(), z.begin()+(i>>1), z.end());
+				zc = c;
+				zc.resize(i<<1);
+				_conv.ntt(zc);
+				vector<mint> x(i, 0);
+				int m = min((int)_v.size(), i);
+				for (int j = 1; j < m; j++) x[j-1] = _v[j] * j;
+				_conv.ntt(x);
+				mint_simd<mint>::mul(x.data(), y.data(), i);
+				_conv.intt(x);
+				for (int j = 1; j < i; j++) x[j-1] -= b[j] * j;
+				x.resize(i<<1);
+				for (int j = 0; j < i-1; j++) {
+					x[i+j] = x[j];
+					x[j] = 0;
+				}
+				_conv.ntt(x);
+				mint_simd<mint>::mul(x.data(), zc.data(), i<<1);
+				_conv.intt(x);
+				for (int j = (i<<1)-1; j >= i; j--) x[j] = x[j-1] * iv[j];
+				m = min((int)_v.size(), i<<1);
+				for (int j = i; j < m; j++) x[j] += _v[j];
+				fill(x.begin(), x.begin()+i, 0);
+				_conv.ntt(x);
+				mint_simd<mint>::mul(x.data(), y.data(), i<<1);
+				_conv.intt(x);
+				b.insert(b.end(), x.begin()+i, x.end());
+			}
+			b.resize(deg);
+			return fps(move(b));
+		} else {
+			fps b = {1, _v.size() > 1 ? _v[1] : 0}, c = {1};
+			for (int i = 2; i < deg; i <<= 1) {
+				c = (c + c * (1 - (b * c).pre(i))).pre(i);
+				fps r = (pre(i<<1).diff() * b).pre((i<<1)-1) - b.diff();
+				b += (b * (r * c).pre((i<<1)-1).integral()).pre(i<<1);
+			}
+			return b.pre(deg);
 		}
-		res = res.pre(deg);
-		return res;
 	}
 
 	/**
-	 * @brief 冪乗 `f^t` を求める。
+	 * @brief 冪乗 `f^t` を求める。非零項が少ない場合は `sparse_pow` を使う。
 	 *
 	 * O(N log N)
 	 * @param t 指数
@@ -250,6 +470,8 @@ struct fps_base {
 			if (deg > 0) res[0] = 1;
 			return res;
 		}
+		vector<pair<int, mint>> sp;
+		if (_sparse_terms(deg, sp) && (t > 0 || (!_v.empty() && _v[0] != 0))) return sparse_pow(sp, t, deg);
 		if (t < 0) return pow(-t, deg).inv();
 		long long z = 0;
 		for (int i = 0; i < _v.size(); i++) {
@@ -264,6 +486,431 @@ struct fps_base {
 		}
 		return fps(deg, 0);
 	}
+
+	/**
+	 * @brief 非零項の列 `f` で表される形式的冪級数の逆数を、係数の漸化式 `f_0 g_n = -\sum_{i>0} f_i g_{n-i}` によって求める。
+	 *
+	 * O(NK)
+	 * @param f 指数と係数の組の列。指数は互いに異なり、定数項が 0 であってはいけない。
+	 * @param deg 求める項数
+	 * @return 逆数
+	 */
+	static fps sparse_inv(const vector<pair<int, mint>> &f, int deg) {
+		if (deg == 0) return fps(0);
+		mint f0 = 0;
+		vector<pair<int, mint>> t;
+		for (auto &p : f) {
+			if (p.first == 0) f0 = p.second;
+			else if (p.first < deg) t.push_back(p);
+		}
+		assert(f0 != 0);
+		mint if0 = f0.inv();
+		fps res(deg, 0);
+		for (int n = 0; n < deg; n++) {
+			mint s = n == 0 ? 1 : 0;
+			for (auto &p : t) {
+				if (p.first <= n) s -= p.second * res[n-p.first];
+			}
+			res[n] = s * if0;
+		}
+		return res;
+	}
+
+	/**
+	 * @brief 非零項の列 `f` で表される形式的冪級数の対数を、 `f g' = f'` の係数の漸化式によって求める。
+	 *
+	 * O(NK)
+	 * @param f 指数と係数の組の列。指数は互いに異なり、定数項が 1 である必要がある。
+	 * @param deg 求める項数
+	 * @return 対数
+	 */
+	static fps sparse_log(const vector<pair<int, mint>> &f, int deg) {
+		if (deg == 0) return fps(0);
+		mint f0 = 0;
+		vector<pair<int, mint>> t;
+		for (auto &p : f) {
+			if (p.first == 0) f0 = p.second;
+			else if (p.first < deg) t.push_back(p);
+		}
+		assert(f0 == 1);
+		const vector<mint> &iv = mint::inv_table(deg);
+		// h = f'/f
+		vector<mint> h(deg-1, 0);
+		for (auto &p : t) h[p.first-1] = p.second * p.first;
+		for (int n = 0; n < deg-1; n++) {
+			for (auto &p : t) {
+				if (p.first <= n) h[n] -= p.second * h[n-p.first];
+			}
+		}
+		fps res(deg, 0);
+		for (int n = 1; n < deg; n++) res[n] = h[n-1] * iv[n];
+		return res;
+	}
+
+	/**
+	 * @brief 非零項の列 `f` で表される形式的冪級数の指数を、 `g' = f' g` の係数の漸化式によって求める。
+	 *
+	 * O(NK)
+	 * @param f 指数と係数の組の列。指数は互いに異なり、定数項が 0 である必要がある。
+	 * @param deg 求める項数
+	 * @return 指数
+	 */
+	static fps sparse_exp(const vector<pair<int, mint>> &f, int deg) {
+		if (deg == 0) return fps(0);
+		vector<pair<int, mint>> t;
+		for (auto &p : f) {
+			if (p.first == 0) assert(p.second == 0);
+			else if (p.first < deg) t.push_back({p.first, p.second * p.first});
+		}
+		const vector<mint> &iv = mint::inv_table(deg);
+		fps res(deg, 0);
+		res[0] = 1;
+		for (int n = 1; n < deg; n++) {
+			mint s = 0;
+			for (auto &p : t) {
+				if (p.first <= n) s += p.second * res[n-p.first];
+			}
+			res[n] = s * iv[n];
+		}
+		return res;
+	}
+
+	/**
+	 * @brief 非零項の列 `f` で表される形式的冪級数の冪乗を、 `f (f^t)' = t f' f^t` の係数の漸化式によって求める。
+	 *
+	 * O(NK)
+	 * @param f 指数と係数の組の列。指数は互いに異なる必要がある。
+	 * @param t 指数。負の場合は `f` の定数項が 0 であってはいけない。
+	 * @param deg 求める項数
+	 * @return 冪乗
+	 */
+	static fps sparse_pow(const vector<pair<int, mint>> &f, long long t, int deg) {
+		fps res(deg, 0);
+		if (deg == 0) return res;
+		if (t == 0) {
+			res[0] = 1;
+			return res;
+		}
+		int z = -1;
+		for (auto &p : f) {
+			if (p.second != 0 && (z == -1 || p.first < z)) z = p.first;
+		}
+		if (z == -1) return res;
+		assert(t > 0 || z == 0);
+		if (z > 0 && t >= (deg + z - 1) / z) return res;
+		int m = deg - z*t;
+		mint f0 = 0;
+		vector<pair<int, mint>> u;
+		for (auto &p : f) {
+			if (p.first == z) f0 = p.second;
+			else if (p.first > z && p.first-z < m) u.push_back({p.first-z, p.second});
+		}
+		const vector<mint> &iv = mint::inv_table(m);
+		mint if0 = f0.inv(), mt = t;
+		vector<mint> g(m, 0);
+		g[0] = f0.pow(t);
+		for (int n = 1; n < m; n++) {
+			mint s = 0;
+			for (auto &p : u) {
+				if (p.first <= n) s += p.second * (mt * p.first - (n - p.first)) * g[n-p.first];
+			}
+			g[n] = s * if0 * iv[n];
+		}
+		for (int n = 0; n < m; n++) res[z*t+n] = g[n];
+		return res;
+	}
+
+	/**
+	 * @brief `g^2 = f` となる平方根 `g` を Newton 法 `g <- (g + f/g)/2` によって求める。 `1/g` も同時に Newton 法で更新し、逆数の再計算を避ける。先頭に偶数個の 0 が続いてもよい。 `mod` が奇素数である必要がある。
+	 *
+	 * O(N log N)
+	 * @param deg 求める項数。指定しない場合、 `size()` が使われる。
+	 * @return 平方根の 1 つ。存在しない場合は空の形式的冪級数
+	 */
+	fps sqrt(int deg=-1) const {
+		if (deg == -1) deg = _v.size();
+		int z = 0;
+		while (z < _v.size() && _v[z] == 0) z++;
+		if (z == _v.size() || z/2 >= deg) return fps(deg, 0);
+		if (z & 1) return fps(0);
+		long long s0 = sqrt_mod(_v[z].val(), _mod);
+		if (s0 == -1) return fps(0);
+		int n = deg - z/2;
+		vector<mint> f(_v.begin()+z, _v.begin()+min((int)_v.size(), z+n));
+		f.resize(n, 0);
+		mint i2 = mint(2).inv();
+		vector<mint> g = {s0}, h = {g[0].inv()};
+		g.reserve(n);
+		for (int i = 1; i < n; i <<= 1) {
+			// f - g^2 は x^i で割り切れるので、 1/g は mod x^i で足りる。
+			if constexpr (ntt_friendly) {
+				vector<mint> a(i<<1, 0), b(i<<1, 0), c(i<<1, 0);
+				for (int j = 0; j < i; j++) a[j] = g[j];
+				for (int j = 0; j < i; j++) b[j] = h[j];
+				_conv.ntt(a);
+				for (int j = 0; j < (i<<1); j++) c[j] = a[j] * a[j];
+				_conv.intt(c);
+				for (int j = 0; j < i; j++) c[j] = (i+j < n ? f[i+j] : 0) - c[i+j];
+				fill(c.begin()+i, c.end(), 0);
+				_conv.ntt(b);
+				_conv.ntt(c);
+				mint_simd<mint>::mul(c.data(), b.data(), i<<1);
+				_conv.intt(c);
+				for (int j = 0; j < i && i+j < n; j++) g.push_back(c[j] * i2);
+				if ((i<<1) >= n) break;
+				// 1/g を mod x^(2i) に更新する。
+				for (int j = 0; j < (i<<1); j++) a[j] = g[j];
+				_conv.ntt(a);
+				mint_simd<mint>::mul(a.data(), b.data(), i<<1);
+				_conv.intt(a);
+				fill(a.begin(), a.begin()+i, 0);
+				_conv.ntt(a);
+				mint_simd<mint>::mul(a.data(), b.data(), i<<1);
+				_conv.intt(a);
+				for (int j = i; j < (i<<1); j++) h.push_back(-a[j]);
+			} else {
+				fps gi(g), hi(h);
+				fps e = (fps(f).pre(i<<1) - gi * gi).pre(i<<1) >> -i;
+				e = (e * hi).pre(i);
+				for (int j = 0; j < i && i+j < n; j++) g.push_back(e[j] * i2);
+				if ((i<<1) >= n) break;
+				fps gn(g);
+				hi = (hi + hi * (1 - (gn * hi).pre(i<<1))).pre(i<<1);
+				h = hi._v;
+			}
+		}
+		g.resize(n);
+		return fps(move(g)) >> z/2;
+	}
+
+	/**
+	 * @brief `f(x+c)` を 1 回の畳み込みによって求める。階乗とその逆元の表はスレッド内の呼び出し間で共有され、必要に応じて伸ばされる。 `mod` が `size()` より大きい素数である必要がある。
+	 *
+	 * O(N log N)
+	 * @param c ずらす量
+	 * @return 項数 `size()` の多項式 `f(x+c)`
+	 */
+	fps taylor_shift(mint c) const {
+		int n = _v.size();
+		if (n == 0) return fps(0);
+		_prepare_fact(n);
+		fps a(n), b(n);
+		for (int i = 0; i < n; i++) a[n-1-i] = _v[i] * _fact[i];
+		mint p = 1;
+		for (int i = 0; i < n; i++) {
+			b[i] = p * _ifact[i];
+			p *= c;
+		}
+		a = (a * b).pre(n);
+		fps res(n);
+		for (int i = 0; i < n; i++) res[i] = a[n-1-i] * _ifact[i];
+		return res;
+	}
+
+	/**
+	 * @brief `f(0), ..., f(N-1)` が並んでいるとみなし、次数 `N-1` 以下の多項式 `f` について `f(m), ..., f(m+cnt-1)` を、 Lagrange 補間の式を 1 回の畳み込みにまとめて求める。 `mod` が `N` より大きい素数である必要がある。 `m` を `[0, mod)` の整数とみなしたとき、 `m <= N-1` であるか、 `m-(N-1), ..., m+cnt-1` が全て mod で 0 でない必要がある。
+	 *
+	 * O((N + cnt) log (N + cnt))
+	 * @param m 最初の点
+	 * @param cnt 求める値の個数。指定しない場合、 `size()` が使われる。
+	 * @return `f(m), ..., f(m+cnt-1)`
+	 */
+	fps sample_point_shift(mint m, int cnt=-1) const {
+		int n = _v.size();
+		if (cnt == -1) cnt = n;
+		fps res(cnt, 0);
+		if (n == 0 || cnt == 0) return res;
+		int d = n - 1;
+		if (m.val() <= d) {
+			// 既知の点と重なる部分は写し、残りは d+1 からずらす。
+			int s = m.val(), c = min(cnt, n-s);
+			for (int k = 0; k < c; k++) res[k] = _v[s+k];
+			if (c < cnt) {
+				fps r = sample_point_shift(n, cnt-c);
+				for (int k = c; k < cnt; k++) res[k] = r[k-c];
+			}
+			return res;
+		}
+		_prepare_fact(n);
+		// f(m+k) = \prod_{j=0}^{d} (m+k-j) \sum_i f(i) / (i! (d-i)! (-1)^(d-i) (m+k-i))
+		fps a(n);
+		for (int i = 0; i < n; i++) {
+			a[i] = _v[i] * _ifact[i] * _ifact[d-i];
+			if ((d-i) & 1) a[i] = -a[i];
+		}
+		vector<mint> b(d+cnt);
+		for (int j = 0; j < d+cnt; j++) b[j] = m-d+j;
+		b = mint::batch_inv(b);
+		a *= fps(b);
+		mint p = 1;
+		for (int j = 0; j <= d; j++) p *= m-j;
+		for (int k = 0; k < cnt; k++) {
+			res[k] = p * a[k+d];
+			p *= (m+k+1) * b[k];
+		}
+		return res;
+	}
+
+	/**
+	 * @brief `i = 0, ..., m-1` について `[x^(N-1)] f g^i` を求める。ただし `N = size()` である。 `[x^(N-1)] f/(1 - y g)` に 2 変数の Bostan–Mori 法を適用し、 `x` の次数を半分にしながら `y` の次数を倍にしていく。
+	 *
+	 * O(N log^2 N + M log M)
+	 * @param g 多項式
+	 * @param m 求める項数
+	 * @return `\sum_i ([x^(N-1)] f g^i) y^i` の先頭 `m` 項
+	 */
+	fps power_projection(const fps &g, int m) const {
+		int n = _v.size();
+		if (n == 0 || m == 0) return fps(m, 0);
+		if constexpr (ntt_friendly) {
+			// Q_k と P_k を同じ長さで変換し、 Q_k(-x, y) の変換は隣り合う組の入れ替えで得る。
+			// x^(nx-1) が奇数次のときは P_k に x を掛けて偶数次の項の取り出しに帰着する。
+			int nx = n, ny = min(2, m), pk = 1;
+			vector<mint> q(nx*ny, 0), p = _v;
+			q[0] = 1;
+			if (ny > 1) {
+				for (int x = 0; x < min(nx, g.size()); x++) q[nx+x] = -g[x];
+			}
+			mint i2 = mint(2).inv();
+			while (nx > 1) {
+				int s = nx<<1, nx2 = (nx+1)>>1, ny2 = min(ny*2-1, m), pk2 = min(pk+ny-1, m), par = (nx-1)&1;
+				int len = 2;
+				while (len < s*(ny*2-1)) len <<= 1;
+				vector<mint> a(len, 0), b(len, 0);
+				for (int y = 0; y < ny; y++) {
+					for (int x = 0; x < nx; x++) a[y*s+x] = q[y*nx+x];
+				}
+				for (int y = 0; y < pk; y++) {
+					for (int x = 0; x < nx; x++) b[y*s+x+par] = p[y*nx+x];
+				}
+				_conv.ntt(a);
+				_conv.ntt(b);
+				vector<mint> c(len>>1), d(len>>1);
+				for (int i = 0; i < (len>>1); i++) {
+					c[i] = a[i<<1] * a[i<<1|1];
+					d[i] = (b[i<<1] * a[i<<1|1] + b[i<<1|1] * a[i<<1]) * i2;
+				}
+				_conv.intt(c);
+				_conv.intt(d);
+				q.assign(nx2*ny2, 0);
+				for (int y = 0; y < ny2; y++) {
+					for (int t = 0; t < nx2; t++) q[y*nx2+t] = c[y*nx+t];
+				}
+				p.assign(nx2*pk2, 0);
+				for (int y = 0; y < pk2; y++) {
+					for (int t = 0; t < nx2; t++) p[y*nx2+t] = d[y*nx+t+par];
+				}
+				nx = nx2;
+				ny = ny2;
+				pk = pk2;
+			}
+			return (fps(move(p)) * fps(move(q)).inv(m)).pre(m);
+		}
+		vector<vector<mint>> q;
+		vector<int> qx, qy, py;
+		_q_chain(g, n, m, q, qx, qy, py);
+		vector<mint> p = _v;
+		for (int k = 0; k+1 < q.size(); k++) {
+			// P_{k+1} は P_k(x, y) Q_k(-x, y) の x^(qx[k]-1) と偶奇が一致する項
+			int nx = qx[k], s = nx<<1, par = (nx-1)&1, nx2 = qx[k+1];
+			vector<mint> a(s*py[k], 0), b(s*qy[k], 0);
+			for (int y = 0; y < py[k]; y++) {
+				for (int x = 0; x < nx; x++) a[y*s+x] = p[y*nx+x];
+			}
+			for (int y = 0; y < qy[k]; y++) {
+				for (int x = 0; x < nx; x++) b[y*s+x] = (x & 1) ? -q[k][y*nx+x] : q[k][y*nx+x];
+			}
+			a = _conv(a, b);
+			p.assign(py[k+1]*nx2, 0);
+			for (int y = 0; y < py[k+1]; y++) {
+				for (int t = 0; t < nx2; t++) p[y*nx2+t] = a[y*s+2*t+par];
+			}
+		}
+		return (fps(move(p)) * fps(q.back()).inv(m)).pre(m);
+	}
+
+	/**
+	 * @brief 合成 `f(g)` を求める。 `power_projection` の転置として、同じ `Q_k` の列を逆順にたどって計算する。
+	 *
+	 * O(N log^2 N + M log M)
+	 * @param g 代入する形式的冪級数。定数項が 0 である必要はない。
+	 * @param deg 求める項数。指定しない場合、 `g.size()` が使われる。
+	 * @return `f(g)` の先頭 `deg` 項
+	 */
+	fps composite(const fps &g, int deg=-1) const {
+		if (deg == -1) deg = g.size();
+		int n = deg, m = _v.size();
+		if (n == 0 || m == 0) return fps(n, 0);
+		vector<vector<mint>> q;
+		vector<int> qx, qy, py;
+		_q_chain(g, n, m, q, qx, qy, py);
+		int l = q.size() - 1;
+		fps r(m);
+		for (int i = 0; i < m; i++) r[m-1-i] = _v[i];
+		r *= fps(q[l]).inv(m);
+		vector<mint> p(py[l]);
+		for (int j = 0; j < py[l]; j++) p[j] = r[m-1-j];
+		for (int k = l-1; k >= 0; k--) {
+			// P_k[y][x] = \sum_{e, c} U[y+e][x+c] Q_k(-x, y)[e][c] を、 Q_k(-x, y) を反転させた掛け算で求める。
+			int nx = qx[k], s = nx<<1, par = (nx-1)&1, nx2 = qx[k+1];
+			int len = s*py[k+1];
+			if constexpr (ntt_friendly) {
+				// 必要な係数は長さ s*py[k+1] 以上の巡回畳み込みで回り込まない。
+				int l2 = 1;
+				while (l2 < max(len, (py[k]+qy[k]-1)*s)) l2 <<= 1;
+				len = l2;
+			}
+			vector<mint> a(len, 0), b(ntt_friendly ? len : s*qy[k], 0);
+			for (int y = 0; y < py[k+1]; y++) {
+				for (int t = 0; t < nx2; t++) a[y*s+2*t+par] = p[y*nx2+t];
+			}
+			for (int y = 0; y < qy[k]; y++) {
+				for (int x = 0; x < nx; x++) b[(qy[k]-1-y)*s+nx-1-x] = (x & 1) ? -q[k][y*nx+x] : q[k][y*nx+x];
+			}
+			if constexpr (ntt_friendly) {
+				_conv.ntt(a);
+				_conv.ntt(b);
+				mint_simd<mint>::mul(a.data(), b.data(), len);
+				_conv.intt(a);
+			} else {
+				a = _conv(a, b);
+			}
+			p.assign(py[k]*nx, 0);
+			for (int y = 0; y < py[k]; y++) {
+				for (int x = 0; x < nx; x++) p[y*nx+x] = a[(y+qy[k]-1)*s+x+nx-1];
+			}
+		}
+		reverse(p.begin(), p.end());
+		return fps(move(p));
+	}
+
+	/**
+	 * @brief `f(g) = x` となる逆関数 `g` を求める。定数項が 0 、 `x` の係数が 0 でない必要がある。 `power_projection` で `[x^(N-1)] f^i` を求め、 Lagrange の反転公式から `(x/g)^(N-1)` を復元する。 `mod` が `deg` より大きい素数である必要がある。
+	 *
+	 * O(N log^2 N)
+	 * @param deg 求める項数。指定しない場合、 `size()` が使われる。
+	 * @return 逆関数
+	 */
+	fps compositional_inverse(int deg=-1) const {
+		assert(_v.size() >= 2 && _v[0] == 0 && _v[1] != 0);
+		if (deg == -1) deg = _v.size();
+		if (deg <= 2) {
+			fps res(deg, 0);
+			if (deg == 2) res[1] = _v[1].inv();
+			return res;
+		}
+		int n = deg;
+		fps w(n, 0);
+		w[0] = 1;
+		fps p = w.power_projection(*this, n);
+		// (n-1) [x^(n-1)] f^i = i [x^(n-1-i)] (x/g)^(n-1)
+		const vector<mint> &iv = mint::inv_table(n);
+		fps a(n-1);
+		for (int i = 1; i < n; i++) a[n-1-i] = p[i] * (n-1) * iv[i];
+		a *= a[0].inv();
+		a = (a.log() * iv[n-1]).exp() * _v[1];
+		return a.inv() >> 1;
+	}
 	friend istream &operator>>(istream &is, fps &f) {
 		for (int i = 0; i < f.size(); i++) is >> f[i];
 		return is;
@@ -276,8 +923,102 @@ struct fps_base {
 		return os;
 	}
 private:
-	constexpr static convolution<mod> _conv {};
+	constexpr static convolution<_mod> _conv {};
+	constexpr static int _naive_threshold = 32;
+	constexpr static int _sparse_factor = ntt_friendly ? 6 : 32;
+	inline static thread_local vector<mint> _fact = {1}, _ifact = {1};
 	vector<mint> _v;
+	static void _prepare_fact(int n) {
+		int m = _fact.size();
+		if (n <= m) return;
+		assert(_uint(n) <= _mod);
+		// mod! 以降は 0 になり逆元を持たないので、 mod 項を超えて伸ばさない。
+		n = min(max(n, m*2), (int)min<long long>(_mod, INT_MAX));
+		_fact.resize(n);
+		_ifact.resize(n);
+		for (int i = m; i < n; i++) _fact[i] = _fact[i-1] * i;
+		_ifact[n-1] = _fact[n-1].inv();
+		for (int i = n-1; i > m; i--) _ifact[i-1] = _ifact[i] * i;
+	}
+	static void _q_chain(const fps &g, int n, int m, vector<vector<mint>> &q, vector<int> &qx, vector<int> &qy, vector<int> &py) {
+		// q[k] は Q_0 = 1 - y g(x) から Q_{k+1}(x^2, y) = Q_k(x, y) Q_k(-x, y) で定まる Q_k を mod (x^qx[k], y^m) で持ち、 x^a y^b の係数を q[k][b*qx[k]+a] に置く。
+		// py[k] は power_projection の途中の P_k の y 方向の項数である。
+		int nx = n, ny = min(2, m), pk = 1;
+		vector<mint> cur(nx*ny, 0);
+		cur[0] = 1;
+		if (ny > 1) {
+			for (int x = 0; x < min(nx, g.size()); x++) cur[nx+x] = -g[x];
+		}
+		while (true) {
+			q.push_back(cur);
+			qx.push_back(nx);
+			qy.push_back(ny);
+			py.push_back(pk);
+			if (nx == 1) break;
+			// 2 変数多項式を x 方向の幅 s = 2nx で 1 変数に埋め込む。
+			int s = nx<<1, nx2 = (nx+1)>>1, ny2 = min(ny*2-1, m);
+			vector<mint> c;
+			if constexpr (ntt_friendly) {
+				// s が偶数なので Q_k(-x, y) の変換は Q_k(x, y) の変換の隣り合う組を入れ替えたものになり、積は x の偶関数なので半分の長さで逆変換できる。
+				int len = 2;
+				while (len < s*(ny*2-1)) len <<= 1;
+				vector<mint> a(len, 0);
+				for (int y = 0; y < ny; y++) {
+					for (int x = 0; x < nx; x++) a[y*s+x] = cur[y*nx+x];
+				}
+				_conv.ntt(a);
+				c.resize(len>>1);
+				for (int i = 0; i < (len>>1); i++) c[i] = a[i<<1] * a[i<<1|1];
+				_conv.intt(c);
+			} else {
+				vector<mint> a(s*ny, 0), b(s*ny, 0);
+				for (int y = 0; y < ny; y++) {
+					for (int x = 0; x < nx; x++) {
+						a[y*s+x] = cur[y*nx+x];
+						b[y*s+x] = (x & 1) ? -cur[y*nx+x] : cur[y*nx+x];
+					}
+				}
+				a = _conv(a, b);
+				c.resize(nx*(ny*2-1), 0);
+				for (int i = 0; i < c.size(); i++) c[i] = a[i<<1];
+			}
+			cur.assign(nx2*ny2, 0);
+			for (int y = 0; y < ny2; y++) {
+				for (int t = 0; t < nx2; t++) cur[y*nx2+t] = c[y*nx+t];
+			}
+			pk = min(pk+ny-1, m);
+			nx = nx2;
+			ny = ny2;
+		}
+	}
+	bool _sparse_terms(int deg, vector<pair<int, mint>> &res) const {
+		// 非零項が K 個のとき、漸化式による計算は NK 回程度の掛け算で済む。 Newton 法の N log N に比べて十分小さい場合のみ true を返す。
+		int lim = _sparse_factor * (__lg(max(deg, 1)) + 1);
+		int m = min((int)_v.size(), deg);
+		for (int i = 0; i < m; i++) {
+			if (_v[i] == 0) continue;
+			if (res.size() >= lim) {
+				res.clear();
+				return false;
+			}
+			res.push_back({i, _v[i]});
+		}
+		return true;
+	}
+	int _deg() const {
+		int d = (int)_v.size() - 1;
+		while (d >= 0 && _v[d] == 0) d--;
+		return d;
+	}
+	fps _div(const fps &b, int n, int m) const {
+		int k = n - m;
+		fps ra(k), rb(min(k, m+1));
+		for (int i = 0; i < k; i++) ra[i] = _v[n-1-i];
+		for (int i = 0; i < rb.size(); i++) rb[i] = b[m-i];
+		ra = (ra * rb.inv(k)).pre(k);
+		reverse(ra._v.begin(), ra._v.end());
+		return ra;
+	}
 };
 
 /**
@@ -0,0 +1,216 @@
+/**
+ * @file half_gcd.hpp
+ * @author rii922
+ * @brief half-GCD による多項式の高速な互除法、最大公約数、終結式
+ * @date 2026-10-19
+ */
+
+#include <bits/stdc++.h>
+#include "fps.hpp"
+using namespace std;
+
+/// EXPAND FROM HERE
+
+/**
+ * @brief half-GCD による多項式の互除法。互除法の途中の変形は行列 `[[m[0], m[1]], [m[2], m[3]]]` で表す。
+ *
+ * @tparam fps 形式的冪級数を扱うクラス
+ */
+template<class fps>
+struct half_gcd {
+	using mint = typename fps::mint;
+	using matrix = array<fps, 4>;
+
+	/**
+	 * @brief 多項式の次数を返す。 0 の場合は -1 を返す。
+	 *
+	 * O(N)
+	 * @param f 多項式
+	 * @return 次数
+	 */
+	static int deg(const fps &f) {
+		int d = f.size() - 1;
+		while (d >= 0 && f[d] == 0) d--;
+		return d;
+	}
+
+	/**
+	 * @brief `m` を `(a, b)` に掛ける。
+	 *
+	 * O(N log N)
+	 * @param m 行列
+	 * @param a, b 多項式
+	 * @return `(m[0] a + m[1] b, m[2] a + m[3] b)` 。次数を超える項は取り除かれ、 0 は長さ 1 となる。
+	 */
+	static pair<fps, fps> apply(const matrix &m, const fps &a, const fps &b) {
+		return {_trim(m[0] * a + m[1] * b), _trim(m[2] * a + m[3] * b)};
+	}
+
+	/**
+	 * @brief `deg(a) > deg(b)` である `(a, b)` に互除法を適用し、余りの次数が初めて `ceil(deg(a)/2)` を下回るまで進める。
+	 *
+	 * O(N log^2 N)
+	 * @param a, b `deg(a) > deg(b)` である多項式
+	 * @return `m (a, b) = (c, d)` かつ `deg(c) >= ceil(deg(a)/2) > deg(d)` となる、互除法の途中の変形を表す行列 `m`
+	 */
+	static matrix hgcd(const fps &a, const fps &b) {
+		return _hgcd(a, b, nullptr, 0);
+	}
+
+	/**
+	 * @brief 互除法を最後まで進める行列を求める。
+	 *
+	 * O(N log^2 N)
+	 * @param a, b 多項式
+	 * @return `m (a, b) = (g, 0)` となる行列 `m` 。 `g` は `a` と `b` の最大公約数の定数倍である。
+	 */
+	static matrix cogcd(const fps &a, const fps &b) {
+		return _euclid(a, b, nullptr, true);
+	}
+
+	/**
+	 * @brief 最大公約数を求める。
+	 *
+	 * O(N log^2 N)
+	 * @param a, b 多項式
+	 * @return モニックな最大公約数。 `a` と `b` がともに 0 の場合は 0 。
+	 */
+	static fps gcd(const fps &a, const fps &b) {
+		return get<0>(ext_gcd(a, b));
+	}
+
+	/**
+	 * @brief 最大公約数と Bézout の等式の係数を求める。
+	 *
+	 * O(N log^2 N)
+	 * @param a, b 多項式
+	 * @return `x a + y b = g` となる `(g, x, y)` 。 `g` はモニックな最大公約数で、 `g` が 0 でなければ `deg(x) < deg(b) - deg(g)` 、 `deg(y) < deg(a) - deg(g)` となる。
+	 */
+	static tuple<fps, fps, fps> ext_gcd(const fps &a, const fps &b) {
+		matrix m = cogcd(a, b);
+		fps g = apply(m, a, b).first;
+		int d = deg(g);
+		if (d < 0) return {g, m[0], m[1]};
+		mint il = g[d].inv();
+		g *= il;
+		m[0] *= il;
+		m[1] *= il;
+		return {move(g), move(m[0]), move(m[1])};
+	}
+
+	/**
+	 * @brief `f` の `mod` を法とする逆元を求める。
+	 *
+	 * O(N log^2 N)
+	 * @param f 多項式
+	 * @param mod 次数 1 以上の多項式
+	 * @return `f g = 1 (mod mod)` となる項数 `deg(mod)` の多項式 `g` 。存在しない場合は空の多項式。
+	 */
+	static fps inv_mod(const fps &f, const fps &mod) {
+		int d = deg(mod);
+		assert(d >= 1);
+		tuple<fps, fps, fps> gxy = ext_gcd(f.mod(mod), mod);
+		if (deg(get<0>(gxy)) != 0) return fps(0);
+		return get<1>(gxy).pre(d);
+	}
+
+	/**
+	 * @brief 終結式 `res(a, b) = lc(a)^deg(b) \prod_{a(α) = 0} b(α)` を、互除法で現れる余りの次数と最高次の係数から求める。
+	 *
+	 * O(N log^2 N)
+	 * @param a, b 多項式
+	 * @return 終結式。いずれかが 0 の場合は 0 。
+	 */
+	static mint resultant(const fps &a, const fps &b) {
+		int da = deg(a), db = deg(b);
+		if (da < 0 || db < 0) return 0;
+		if (da < db) {
+			mint res = resultant(b, a);
+			return (da & db & 1) ? -res : res;
+		}
+		// r[0] = a, r[1] = b, ... について res(r[i-1], r[i]) = (-1)^(n[i-1] n[i]) l[i]^(n[i-1] - n[i+1]) res(r[i], r[i+1])
+		vector<pair<int, mint>> rem = {_lead(a)};
+		_euclid(a, b, &rem, false);
+		int k = rem.size() - 1;
+		if (rem[k].first > 0) return 0;
+		mint res = 1;
+		for (int i = 1; i < k; i++) {
+			if (rem[i-1].first & rem[i].first & 1) res = -res;
+			res *= rem[i].second.pow(rem[i-1].first - rem[i+1].first);
+		}
+		return res * rem[k].second.pow(rem[k-1].first);
+	}
+private:
+	constexpr static int _naive_threshold = 64;
+	static pair<int, mint> _lead(const fps &f) {
+		int d = deg(f);
+		return {d, f[d]};
+	}
+	static matrix _hgcd(const fps &a, const fps &b, vector<pair<int, mint>> *rem, int shift) {
+		// rem が空でなければ、割る数として使った余りの次数と最高次の係数を順に積む。商が正しいので、これらも正しい。
+		int da = deg(a), db = deg(b);
+		assert(da > db);
+		int m = (da + 1) / 2;
+		if (db < m) return _identity();
+		if (da <= _naive_threshold) return _naive(a, b, m, rem, shift);
+		// 上位の項だけで互除法を進めても、 m 次以上の部分の商は変わらない。
+		matrix r = _hgcd(a << m, b << m, rem, shift + m);
+		pair<fps, fps> cd = apply(r, a, b);
+		if (deg(cd.second) < m) return r;
+		if (rem) rem->push_back({deg(cd.second) + shift, cd.second[deg(cd.second)]});
+		pair<fps, fps> qe = cd.first.divmod(cd.second);
+		r = _step(r, qe.first);
+		int l = deg(cd.second), k = 2*m - l;
+		if (deg(qe.second) < m) return r;
+		return _mul(_hgcd(cd.second << k, _trim(qe.second) << k, rem, shift + k), r);
+	}
+	static matrix _euclid(fps a, fps b, vector<pair<int, mint>> *rem, bool track) {
+		// track が false なら、変形を表す行列は更新しない。
+		matrix r = _identity();
+		a = _trim(a);
+		b = _trim(b);
+		if (deg(a) < deg(b)) {
+			swap(a, b);
+			r = {fps{0}, fps{1}, fps{1}, fps{0}};
+		}
+		while (deg(b) >= 0) {
+			if (deg(a) > deg(b)) {
+				matrix s = _hgcd(a, b, rem, 0);
+				tie(a, b) = apply(s, a, b);
+				if (track) r = _mul(s, r);
+				if (deg(b) < 0) break;
+			}
+			if (rem) rem->push_back(_lead(b));
+			pair<fps, fps> qe = a.divmod(b);
+			if (track) r = _step(r, qe.first);
+			a = move(b);
+			b = _trim(qe.second);
+		}
+		return r;
+	}
+	static fps _trim(const fps &f) {
+		// 空の多項式どうしの掛け算を避けるため、 0 は長さ 1 で表す。
+		return f.pre(max(deg(f), 0) + 1);
+	}
+	static matrix _identity() {
+		return {fps{1}, fps{0}, fps{0}, fps{1}};
+	}
+	static matrix _step(const matrix &r, const fps &q) {
+		// [[0, 1], [1, -q]] r
+		return {r[2], r[3], _trim(r[0] - q * r[2]), _trim(r[1] - q * r[3])};
+	}
+	static matrix _mul(const matrix &s, const matrix &r) {
+		return {_trim(s[0] * r[0] + s[1] * r[2]), _trim(s[0] * r[1] + s[1] * r[3]), _trim(s[2] * r[0] + s[3] * r[2]), _trim(s[2] * r[1] + s[3] * r[3])};
+	}
+	static matrix _naive(fps a, fps b, int m, vector<pair<int, mint>> *rem, int shift) {
+		matrix r = _identity();
+		while (deg(b) >= m) {
+			if (rem) rem->push_back({deg(b) + shift, b[deg(b)]});
+			pair<fps, fps> qe = a.divmod(b);
+			r = _step(r, qe.first);
+			a = move(b);
+			b = _trim(qe.second);
+		}
+		return r;
+	}
+};
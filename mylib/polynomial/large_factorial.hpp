@@ -0,0 +1,65 @@
+/**
+ * @file large_factorial.hpp
+ * @author rii922
+ * @brief 標本点のずらしによる大きな階乗の剰余
+ * @date 2026-10-19
+ */
+
+#include <bits/stdc++.h>
+#include "fps.hpp"
+using namespace std;
+
+/// EXPAND FROM HERE
+
+/**
+ * @brief `n!` を `fps` の `mod` で割った余りを求める。 `v = floor(sqrt(n))` として `g_d(x) = \prod_{i=1}^{d} (vx + i)` の `x = 0, ..., d` での値を、 `sample_point_shift` によって `d` を倍にしながら求め、 `n! = \prod_{x=0}^{v-1} g_v(x) \prod_{i=v^2+1}^{n} i` とする。 `n > mod/2` の場合は Wilson の定理によって `mod-1-n` の階乗に帰着する。 `mod` が素数である必要がある。
+ *
+ * O(sqrt(N) log N)
+ * @tparam fps 形式的冪級数を扱うクラス
+ * @param n 非負整数
+ * @return `n!` を `mod` で割った余り
+ */
+template<class fps>
+typename fps::mint large_factorial(long long n) {
+	using mint = typename fps::mint;
+	constexpr long long naive_threshold = 1 << 16;
+	long long p = mint::get_mod();
+	if (n >= p) return 0;
+	if (n > p/2) {
+		// n! (-1)^(p-1-n) (p-1-n)! = (p-1)! = -1
+		mint res = -large_factorial<fps>(p-1-n).inv();
+		return (p-1-n) & 1 ? -res : res;
+	}
+	if (n <= naive_threshold) {
+		mint res = 1;
+		for (int i = 2; i <= n; i++) res *= i;
+		return res;
+	}
+	long long v = sqrtl(n);
+	while (v*v > n) v--;
+	while ((v+1)*(v+1) <= n) v++;
+	// n <= mod/2 より、ずらした点が既知の点と mod で一致することはない。
+	mint iv = mint(v).inv();
+	fps g = {1, v+1};
+	int d = 1;
+	for (int b = __lg(v)-1; b >= 0; b--) {
+		fps x = g.sample_point_shift(d+1, d+1), y = g.sample_point_shift(mint(d) * iv, d*2+2);
+		fps h(d*2+1);
+		for (int i = 0; i <= d; i++) h[i] = g[i] * y[i];
+		for (int i = d+1; i <= d*2; i++) h[i] = x[i-d-1] * y[i];
+		g = move(h);
+		d *= 2;
+		if (v >> b & 1) {
+			fps h(d+2);
+			for (int i = 0; i <= d; i++) h[i] = g[i] * (mint(v) * i + d + 1);
+			h[d+1] = 1;
+			for (int i = 1; i <= d+1; i++) h[d+1] *= mint(v) * (d+1) + i;
+			g = move(h);
+			d++;
+		}
+	}
+	mint res = 1;
+	for (int i = 0; i < v; i++) res *= g[i];
+	for (long long i = v*v+1; i <= n; i++) res *= i;
+	return res;
+}
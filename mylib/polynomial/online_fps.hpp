@@ -0,0 +1,224 @@
+/**
+ * @file online_fps.hpp
+ * @author rii922
+ * @brief 係数を 1 つずつ受け取る形式的冪級数の積、逆数、指数、対数
+ * @date 2026-10-19
+ */
+
+#include <bits/stdc++.h>
+#include "fps.hpp"
+using namespace std;
+
+/// EXPAND FROM HERE
+
+/**
+ * @brief `a` と `b` の係数を 1 つずつ受け取り、積 `c = ab` の係数を順に返す (relaxed multiplication)。 `i, j >= 1` の組 `a_i b_j` を、 2 冪の `s` と `m >= 1` について `[s, 2s) x [ms, (m+1)s)` および `m >= 2` について `[ms, (m+1)s) x [s, 2s)` のブロックに分け、各ブロックを必要になる直前にまとめて計算する。 NTT が使える場合、 `[s, 2s)` の部分の変換は使い回す。
+ *
+ * 全体で O(N log^2 N)
+ * @tparam fps 形式的冪級数を扱うクラス
+ */
+template<class fps>
+struct relaxed_convolution {
+	using mint = typename fps::mint;
+
+	/**
+	 * @brief 次の係数 `a_n` と `b_n` を受け取り、 `c_n` を返す。
+	 *
+	 * ならし O(log^2 N)
+	 * @param x `a_n`
+	 * @param y `b_n`
+	 * @return `c_n = \sum_{i+j=n} a_i b_j`
+	 */
+	mint push(const mint &x, const mint &y) {
+		int n = _a.size();
+		_a.push_back(x);
+		_b.push_back(y);
+		if (_c.size() < n*2+1) _c.resize(n*2+1, 0);
+		if (n == 0) _c[0] += x * y;
+		else _c[n] += x * _b[0] + _a[0] * y;
+		// ブロック [s, 2s) x [ms, (m+1)s) は c の (m+1)s = n+1 次以上の項にのみ寄与する。
+		for (int s = 1; (n+1) % s == 0 && s*2 <= n+1; s <<= 1) {
+			int m = (n+1) / s - 1;
+			if (s <= _naive_threshold) {
+				for (int i = s; i < s*2; i++) {
+					for (int j = m*s; j < (m+1)*s; j++) {
+						_c[i+j] += _a[i] * _b[j];
+						if (m >= 2) _c[i+j] += _a[j] * _b[i];
+					}
+				}
+				continue;
+			}
+			if constexpr (fps::ntt_friendly) {
+				int k = __lg(s);
+				if (_ta.size() <= k) {
+					_ta.resize(k+1);
+					_tb.resize(k+1);
+				}
+				if (_ta[k].empty()) {
+					_ta[k].assign(s*2, 0);
+					_tb[k].assign(s*2, 0);
+					for (int i = 0; i < s; i++) {
+						_ta[k][i] = _a[s+i];
+						_tb[k][i] = _b[s+i];
+					}
+					fps::ntt(_ta[k]);
+					fps::ntt(_tb[k]);
+				}
+				vector<mint> u(s*2, 0);
+				for (int i = 0; i < s; i++) u[i] = _b[m*s+i];
+				fps::ntt(u);
+				for (int i = 0; i < s*2; i++) u[i] *= _ta[k][i];
+				if (m >= 2) {
+					vector<mint> v(s*2, 0);
+					for (int i = 0; i < s; i++) v[i] = _a[m*s+i];
+					fps::ntt(v);
+					for (int i = 0; i < s*2; i++) u[i] += v[i] * _tb[k][i];
+				}
+				fps::intt(u);
+				for (int i = 0; i < s*2-1; i++) _c[n+1+i] += u[i];
+			} else {
+				fps u = fps(vector<mint>(_a.begin()+s, _a.begin()+s*2)) * fps(vector<mint>(_b.begin()+m*s, _b.begin()+(m+1)*s));
+				if (m >= 2) u += fps(vector<mint>(_a.begin()+m*s, _a.begin()+(m+1)*s)) * fps(vector<mint>(_b.begin()+s, _b.begin()+s*2));
+				for (int i = 0; i < s*2-1; i++) _c[n+1+i] += u[i];
+			}
+		}
+		return _c[n];
+	}
+
+	/**
+	 * @brief 受け取った係数の個数を返す。
+	 *
+	 * @return 受け取った係数の個数
+	 */
+	int size() const {
+		return _a.size();
+	}
+private:
+	constexpr static int _naive_threshold = 16;
+	vector<mint> _a, _b, _c;
+	vector<vector<mint>> _ta, _tb;
+};
+
+/**
+ * @brief `f` の係数を 1 つずつ受け取り、逆数 `g = 1/f` の係数を順に返す。 `f_0 g_n = -\sum_{i>=1} f_i g_{n-i}` の右辺を、 `(f - f_0)/x` と `g` の relaxed multiplication で求める。
+ *
+ * 全体で O(N log^2 N)
+ * @tparam fps 形式的冪級数を扱うクラス
+ */
+template<class fps>
+struct online_inv {
+	using mint = typename fps::mint;
+
+	/**
+	 * @brief 次の係数 `f_n` を受け取り、 `g_n` を返す。 `f_0` は 0 であってはいけない。
+	 *
+	 * ならし O(log^2 N)
+	 * @param x `f_n`
+	 * @return `g_n`
+	 */
+	mint push(const mint &x) {
+		if (_g.empty()) {
+			assert(x != 0);
+			_if0 = x.inv();
+			_g.push_back(_if0);
+		} else {
+			_g.push_back(-_conv.push(x, _g.back()) * _if0);
+		}
+		return _g.back();
+	}
+
+	/**
+	 * @brief これまでに求めた `g` の係数を返す。
+	 *
+	 * @return `g` の先頭 `n` 項
+	 */
+	fps get() const {
+		return fps(_g);
+	}
+private:
+	relaxed_convolution<fps> _conv;
+	vector<mint> _g;
+	mint _if0;
+};
+
+/**
+ * @brief `f` の係数を 1 つずつ受け取り、指数 `g = exp f` の係数を順に返す。 `n g_n = \sum_{k>=1} k f_k g_{n-k}` の右辺を、 `f'` と `g` の relaxed multiplication で求める。 `mod` が素数である必要がある。
+ *
+ * 全体で O(N log^2 N)
+ * @tparam fps 形式的冪級数を扱うクラス
+ */
+template<class fps>
+struct online_exp {
+	using mint = typename fps::mint;
+
+	/**
+	 * @brief 次の係数 `f_n` を受け取り、 `g_n` を返す。 `f_0` は 0 である必要がある。
+	 *
+	 * ならし O(log^2 N)
+	 * @param x `f_n`
+	 * @return `g_n`
+	 */
+	mint push(const mint &x) {
+		int n = _g.size();
+		if (n == 0) {
+			assert(x == 0);
+			_g.push_back(1);
+		} else {
+			_g.push_back(_conv.push(x * n, _g.back()) * mint::inv_table(n)[n]);
+		}
+		return _g.back();
+	}
+
+	/**
+	 * @brief これまでに求めた `g` の係数を返す。
+	 *
+	 * @return `g` の先頭 `n` 項
+	 */
+	fps get() const {
+		return fps(_g);
+	}
+private:
+	relaxed_convolution<fps> _conv;
+	vector<mint> _g;
+};
+
+/**
+ * @brief `f` の係数を 1 つずつ受け取り、対数 `g = log f` の係数を順に返す。 `n g_n = n f_n - \sum_{j=1}^{n-1} j g_j f_{n-j}` の和を、 `x g'` と `(f - 1)/x` の relaxed multiplication で求める。 `mod` が素数である必要がある。
+ *
+ * 全体で O(N log^2 N)
+ * @tparam fps 形式的冪級数を扱うクラス
+ */
+template<class fps>
+struct online_log {
+	using mint = typename fps::mint;
+
+	/**
+	 * @brief 次の係数 `f_n` を受け取り、 `g_n` を返す。 `f_0` は 1 である必要がある。
+	 *
+	 * ならし O(log^2 N)
+	 * @param x `f_n`
+	 * @return `g_n`
+	 */
+	mint push(const mint &x) {
+		int n = _g.size();
+		if (n == 0) {
+			assert(x == 1);
+			_g.push_back(0);
+		} else {
+			_g.push_back(x - _conv.push(_g.back() * (n-1), x) * mint::inv_table(n)[n]);
+		}
+		return _g.back();
+	}
+
+	/**
+	 * @brief これまでに求めた `g` の係数を返す。
+	 *
+	 * @return `g` の先頭 `n` 項
+	 */
+	fps get() const {
+		return fps(_g);
+	}
+private:
+	relaxed_convolution<fps> _conv;
+	vector<mint> _g;
+};
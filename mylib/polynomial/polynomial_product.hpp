@@ -0,0 +1,80 @@
+/**
+ * @file polynomial_product.hpp
+ * @author rii922
+ * @brief 多数の多項式の積
+ * @date 2026-10-19
+ */
+
+#include <bits/stdc++.h>
+#include "fps.hpp"
+using namespace std;
+
+/// EXPAND FROM HERE
+
+/**
+ * @brief 多項式の列 `f` の積を求める。次数の小さいものから順に 2 つずつ掛け合わせる (Huffman 順) ことで、各項の次数の和を `N` として全体の計算量を抑える。各段では小さい方から組にした独立な掛け算を複数のスレッドで行い、小さい多項式どうしの掛け算は筆算で行う。
+ *
+ * O(N log^2 N)
+ * @tparam fps 形式的冪級数を扱うクラス
+ * @param f 多項式の列
+ * @param threads 使うスレッドの数。指定しない場合、 `thread::hardware_concurrency()` が使われる。
+ * @return 項数 `\sum (f[i].size()-1) + 1` の積。 `f` が空の場合は 1
+ */
+template<class fps>
+fps polynomial_product(vector<fps> f, int threads=0) {
+	constexpr int naive_threshold = 32, parallel_threshold = 1 << 15;
+	if (f.empty()) return fps{1};
+	for (int i = 0; i < f.size(); i++) {
+		if (f[i].empty()) return fps(0);
+	}
+	if (threads <= 0) threads = max<int>(thread::hardware_concurrency(), 1);
+	auto mul = [&](const fps &a, const fps &b) {
+		if (min(a.size(), b.size()) > naive_threshold) return a * b;
+		fps res(a.size()+b.size()-1, 0);
+		for (int i = 0; i < a.size(); i++) {
+			for (int j = 0; j < b.size(); j++) res[i+j] += a[i] * b[j];
+		}
+		return res;
+	};
+	// 項数の最小ヒープ。取り出すときに多項式をコピーしないよう、 vector 上で管理する。
+	auto cmp = [](const fps &a, const fps &b) { return a.size() > b.size(); };
+	auto pop = [&]() {
+		pop_heap(f.begin(), f.end(), cmp);
+		fps res = move(f.back());
+		f.pop_back();
+		return res;
+	};
+	make_heap(f.begin(), f.end(), cmp);
+	while (f.size() > 1) {
+		// 小さい方から組にして取り出す。奇数個の場合の余りは次の段に回す。
+		int k = f.size() / 2;
+		vector<fps> a, b;
+		long long total = 0;
+		for (int i = 0; i < k; i++) {
+			a.push_back(pop());
+			b.push_back(pop());
+			total += a.back().size() + b.back().size();
+		}
+		vector<fps> c(k, fps(0));
+		int t = min<long long>({threads, k, total / parallel_threshold + 1});
+		if (t <= 1) {
+			for (int i = 0; i < k; i++) c[i] = mul(a[i], b[i]);
+		} else {
+			// 大きい組から順に、空いたスレッドが取っていく。
+			atomic<int> next = k;
+			vector<thread> th;
+			for (int j = 0; j < t; j++) {
+				th.emplace_back([&]() {
+					int i;
+					while ((i = --next) >= 0) c[i] = mul(a[i], b[i]);
+				});
+			}
+			for (auto &x : th) x.join();
+		}
+		for (int i = 0; i < k; i++) {
+			f.push_back(move(c[i]));
+			push_heap(f.begin(), f.end(), cmp);
+		}
+	}
+	return f[0];
+}
@@ -0,0 +1,240 @@
+/**
+ * @file subproduct_tree.hpp
+ * @author rii922
+ * @brief 部分積木による多点評価および補間
+ * @date 2026-10-19
+ */
+
+#include <bits/stdc++.h>
+#include "fps.hpp"
+using namespace std;
+
+/// EXPAND FROM HERE
+
+/**
+ * @brief 点 `x[0], ..., x[n-1]` に対する部分積木。各頂点は `\prod (1 - x[i] X)` を保持し、多点評価と補間で同じ木を使い回す。木は 1 本の配列上に置かれ、 NTT が使える場合は各頂点の子の変換も保持する。
+ *
+ * @tparam fps 形式的冪級数を扱うクラス
+ */
+template<class fps>
+struct subproduct_tree {
+	using mint = typename fps::mint;
+
+	/**
+	 * @brief 点 `x` に対する部分積木を構築する。
+	 *
+	 * O(N log^2 N)
+	 * @param x 点
+	 */
+	subproduct_tree(const vector<mint> &x) : _n(x.size()), _off(_n*2), _sz(_n*2), _toff(_n*2, -1), _tlen(_n*2, 0) {
+		if (_n == 0) return;
+		for (int i = 0; i < _n; i++) _sz[_n+i] = 1;
+		for (int i = _n-1; i >= 1; i--) _sz[i] = _sz[i<<1] + _sz[i<<1|1];
+		int total = 0;
+		for (int i = 1; i < _n*2; i++) {
+			_off[i] = total;
+			total += _sz[i] + 1;
+		}
+		if constexpr (fps::ntt_friendly) {
+			for (int i = 1; i < _n; i++) {
+				if (_sz[i] <= _naive_threshold) continue;
+				_tlen[i] = 1;
+				while (_tlen[i] < _sz[i]) _tlen[i] <<= 1;
+				_toff[i] = total;
+				total += _tlen[i] * 2;
+			}
+		}
+		_arena.assign(total, 0);
+		for (int i = 0; i < _n; i++) {
+			_arena[_off[_n+i]] = 1;
+			_arena[_off[_n+i]+1] = -x[i];
+		}
+		for (int i = _n-1; i >= 1; i--) _build(i);
+	}
+
+	/**
+	 * @brief 点の個数を返す。
+	 *
+	 * @return 点の個数
+	 */
+	int size() const {
+		return _n;
+	}
+
+	/**
+	 * @brief 全ての点に対する積 `\prod (1 - x[i] X)` を返す。
+	 *
+	 * @return 項数 `size()+1` の多項式
+	 */
+	fps product() const {
+		if (_n == 0) return fps{1};
+		return fps(vector<mint>(_arena.begin()+_off[1], _arena.begin()+_off[1]+_sz[1]+1));
+	}
+
+	/**
+	 * @brief 各点における `f` の値を、転置した剰余の計算 (middle product) によって求める。
+	 *
+	 * O(N log^2 N + M log M)
+	 * @param f 多項式
+	 * @return `f(x[0]), ..., f(x[n-1])`
+	 */
+	vector<mint> evaluate(const fps &f) const {
+		if (_n == 0) return {};
+		int m = max(f.size(), _n);
+		// u[i] は頂点 i の点集合 S について、 \sum_k f_k [X^(k-j)] 1/\prod_{S} (1 - x X) を j の降順に並べたもの
+		vector<mint> u(_arena.size());
+		fps fr(m);
+		for (int i = 0; i < f.size(); i++) fr[m-1-i] = f[i];
+		fr = (fr * product().inv(m)).pre(m);
+		for (int i = 0; i < _n; i++) u[_off[1]+i] = fr[m-_n+i];
+		for (int i = 1; i < _n; i++) {
+			int l = i<<1, r = i<<1|1;
+			if constexpr (fps::ntt_friendly) {
+				if (_toff[i] >= 0) {
+					_middle_ntt(u, i);
+					continue;
+				}
+			}
+			_middle(u, i, l, r);
+			_middle(u, i, r, l);
+		}
+		vector<mint> res(_n);
+		for (int i = 0; i < _n; i++) res[i] = u[_off[_n+i]];
+		return res;
+	}
+
+	/**
+	 * @brief `f(x[i]) = y[i]` となる次数 `size()-1` 以下の多項式 `f` を求める。点は互いに異なる必要がある。
+	 *
+	 * O(N log^2 N)
+	 * @param y 各点における値
+	 * @return 項数 `size()` の多項式
+	 */
+	fps interpolate(const vector<mint> &y) const {
+		assert(y.size() == _n);
+		if (_n == 0) return fps(0);
+		// \prod (X - x[i]) の微分の各点での値から重みを求める。
+		fps dm(_n);
+		for (int k = 0; k < _n; k++) dm[k] = _arena[_off[1]+_n-1-k] * (k + 1);
+		vector<mint> w = mint::batch_inv(evaluate(dm));
+		for (int i = 0; i < _n; i++) w[i] *= y[i];
+		// u[i] は \sum_{j \in S} w[j] \prod_{k \in S, k \neq j} (1 - x[k] X)
+		vector<mint> u(_arena.size());
+		for (int i = 0; i < _n; i++) u[_off[_n+i]] = w[i];
+		for (int i = _n-1; i >= 1; i--) {
+			int l = i<<1, r = i<<1|1;
+			if constexpr (fps::ntt_friendly) {
+				if (_toff[i] >= 0) {
+					_combine_ntt(u, i);
+					continue;
+				}
+			}
+			_combine(u, i, l, r);
+			_combine(u, i, r, l);
+		}
+		fps res(_n);
+		for (int i = 0; i < _n; i++) res[i] = u[_off[1]+_n-1-i];
+		return res;
+	}
+private:
+	constexpr static int _naive_threshold = 32;
+	int _n;
+	vector<int> _off, _sz, _toff, _tlen;
+	vector<mint> _arena;
+	void _build(int i) {
+		int l = i<<1, r = i<<1|1;
+		mint *p = _arena.data() + _off[i];
+		const mint *pl = _arena.data() + _off[l];
+		const mint *pr = _arena.data() + _off[r];
+		if constexpr (fps::ntt_friendly) {
+			if (_toff[i] >= 0) {
+				_build_ntt(i);
+				return;
+			}
+		}
+		if (_sz[i] <= _naive_threshold) {
+			for (int j = 0; j <= _sz[l]; j++) {
+				for (int k = 0; k <= _sz[r]; k++) p[j+k] += pl[j] * pr[k];
+			}
+		} else {
+			fps a(vector<mint>(pl, pl+_sz[l]+1)), b(vector<mint>(pr, pr+_sz[r]+1));
+			a *= b;
+			for (int j = 0; j <= _sz[i]; j++) p[j] = a[j];
+		}
+	}
+	void _build_ntt(int i) {
+		// 定数項が 1 であることを使い、長さ _sz[i] 以上の巡回畳み込みで求める。
+		int l = i<<1, r = i<<1|1, len = _tlen[i];
+		vector<mint> sl(len, 0), sr(len, 0);
+		for (int j = 0; j <= _sz[l]; j++) sl[j] = _arena[_off[l]+j];
+		for (int j = 0; j <= _sz[r]; j++) sr[j] = _arena[_off[r]+j];
+		fps::ntt(sl);
+		fps::ntt(sr);
+		for (int j = 0; j < len; j++) {
+			_arena[_toff[i]+j] = sl[j];
+			_arena[_toff[i]+len+j] = sr[j];
+			sl[j] *= sr[j];
+		}
+		fps::intt(sl);
+		for (int j = 0; j < len && j <= _sz[i]; j++) _arena[_off[i]+j] = sl[j];
+		if (len == _sz[i]) {
+			_arena[_off[i]+_sz[i]] = sl[0] - 1;
+			_arena[_off[i]] = 1;
+		}
+	}
+	void _middle_ntt(vector<mint> &u, int i) const {
+		// 必要な係数は長さ _sz[i] 以上の巡回畳み込みで回り込まない。
+		int l = i<<1, r = i<<1|1, len = _tlen[i];
+		vector<mint> s(len, 0);
+		for (int j = 0; j < _sz[i]; j++) s[j] = u[_off[i]+j];
+		fps::ntt(s);
+		vector<mint> sl(len), sr(len);
+		for (int j = 0; j < len; j++) {
+			sl[j] = s[j] * _arena[_toff[i]+len+j];
+			sr[j] = s[j] * _arena[_toff[i]+j];
+		}
+		fps::intt(sl);
+		fps::intt(sr);
+		for (int j = 0; j < _sz[l]; j++) u[_off[l]+j] = sl[_sz[r]+j];
+		for (int j = 0; j < _sz[r]; j++) u[_off[r]+j] = sr[_sz[l]+j];
+	}
+	void _combine_ntt(vector<mint> &u, int i) const {
+		int l = i<<1, r = i<<1|1, len = _tlen[i];
+		vector<mint> sl(len, 0), sr(len, 0);
+		for (int j = 0; j < _sz[l]; j++) sl[j] = u[_off[l]+j];
+		for (int j = 0; j < _sz[r]; j++) sr[j] = u[_off[r]+j];
+		fps::ntt(sl);
+		fps::ntt(sr);
+		for (int j = 0; j < len; j++) sl[j] = sl[j] * _arena[_toff[i]+len+j] + sr[j] * _arena[_toff[i]+j];
+		fps::intt(sl);
+		for (int j = 0; j < _sz[i]; j++) u[_off[i]+j] = sl[j];
+	}
+	void _combine(vector<mint> &u, int i, int c, int o) const {
+		// u[i] += u[c] * p[o]
+		if (_sz[i] <= _naive_threshold) {
+			for (int j = 0; j < _sz[c]; j++) {
+				for (int k = 0; k <= _sz[o]; k++) u[_off[i]+j+k] += u[_off[c]+j] * _arena[_off[o]+k];
+			}
+		} else {
+			fps a(vector<mint>(u.begin()+_off[c], u.begin()+_off[c]+_sz[c]));
+			fps b(vector<mint>(_arena.begin()+_off[o], _arena.begin()+_off[o]+_sz[o]+1));
+			a *= b;
+			for (int j = 0; j < _sz[i]; j++) u[_off[i]+j] += a[j];
+		}
+	}
+	void _middle(vector<mint> &u, int i, int c, int o) const {
+		// u[c][t] = \sum_k p[o][k] u[i][_sz[o]+t-k]
+		if (_sz[i] <= _naive_threshold) {
+			for (int t = 0; t < _sz[c]; t++) {
+				mint s = 0;
+				for (int k = 0; k <= _sz[o]; k++) s += _arena[_off[o]+k] * u[_off[i]+_sz[o]+t-k];
+				u[_off[c]+t] = s;
+			}
+		} else {
+			fps a(vector<mint>(_arena.begin()+_off[o], _arena.begin()+_off[o]+_sz[o]+1));
+			fps b(vector<mint>(u.begin()+_off[i], u.begin()+_off[i]+_sz[i]));
+			a *= b;
+			for (int t = 0; t < _sz[c]; t++) u[_off[c]+t] = a[_sz[o]+t];
+		}
+	}
+};
@@ -0,0 +1,76 @@
+/**
+ * @file subset_sum.hpp
+ * @author rii922
+ * @brief 形式的冪級数の exp による部分和の数え上げ
+ * @date 2026-10-19
+ */
+
+#include <bits/stdc++.h>
+#include "fps.hpp"
+using namespace std;
+
+/// EXPAND FROM HERE
+
+/**
+ * @brief `\prod (1 + x^a[i])` または `\prod 1 / (1 - x^a[i])` の `t` 次までを求める。等しい `a[i]` をまとめ、 `log` を調和級数の要領で足し合わせてから 1 回の `exp` で戻す。
+ *
+ * @tparam fps 形式的冪級数を扱うクラス
+ * @param a 非負整数の列
+ * @param t 次数の上限
+ * @param multiset true の場合は各要素を何個でも使える
+ * @return 項数 `t+1` の形式的冪級数
+ */
+template<class fps>
+fps _subset_sum(const vector<int> &a, int t, bool multiset) {
+	using mint = typename fps::mint;
+	vector<int> cnt(t+1, 0);
+	long long zero = 0;
+	for (int x : a) {
+		assert(x >= 0);
+		if (x == 0) zero++;
+		else if (x <= t) cnt[x]++;
+	}
+	assert(!multiset || zero == 0);
+	const vector<mint> &iv = mint::inv_table(t);
+	// log(1 + x^d) = \sum_k (-1)^(k+1) x^(dk) / k 、 -log(1 - x^d) = \sum_k x^(dk) / k
+	fps f(t+1, 0);
+	for (int d = 1; d <= t; d++) {
+		if (cnt[d] == 0) continue;
+		for (int k = 1; d*k <= t; k++) {
+			mint c = iv[k] * cnt[d];
+			if (!multiset && !(k & 1)) f[d*k] -= c;
+			else f[d*k] += c;
+		}
+	}
+	f = f.exp();
+	if (zero) f *= mint(2).pow(zero);
+	return f;
+}
+
+/**
+ * @brief `a` の部分集合のうち、和が `0, ..., t` となるものの個数を求める。
+ *
+ * O(N + T log T)
+ * @tparam fps 形式的冪級数を扱うクラス
+ * @param a 非負整数の列
+ * @param t 和の上限
+ * @return 項数 `t+1` の形式的冪級数 `\prod (1 + x^a[i])`
+ */
+template<class fps>
+fps subset_sum(const vector<int> &a, int t) {
+	return _subset_sum<fps>(a, t, false);
+}
+
+/**
+ * @brief `a` の各要素を何個でも使えるとき、和が `0, ..., t` となる選び方の個数を求める。
+ *
+ * O(N + T log T)
+ * @tparam fps 形式的冪級数を扱うクラス
+ * @param a 正整数の列
+ * @param t 和の上限
+ * @return 項数 `t+1` の形式的冪級数 `\prod 1 / (1 - x^a[i])`
+ */
+template<class fps>
+fps multiset_sum(const vector<int> &a, int t) {
+	return _subset_sum<fps>(a, t, true);
+}
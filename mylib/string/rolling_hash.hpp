@@ -1,5 +1,7 @@
 #include <bits/stdc++.h>
-#include "montgomery_mint.cpp"
+#include "../mint/montgomery_mint.hpp"
+#include "../mint/fixed_base_pow.hpp"
+#include "../data_structure/fenwick_tree.hpp"
 using namespace std;
 
 /// EXPAND FROM HERE
@@ -39,44 +41,52 @@ struct rolling_hash {
 	}
 	void set(int p, T x) {
 		for (int i = 0; i < base_size; i++) {
-			_value998244353[i].set(p, static_mint<998244353>(_base[i]).pow(p)*x);
-			_value1000000007[i].set(p, static_mint<1000000007>(_base[i]).pow(p)*x);
-			_value1000000009[i].set(p, static_mint<1000000009>(_base[i]).pow(p)*x);
-			_value1000000021[i].set(p, static_mint<1000000021>(_base[i]).pow(p)*x);
-			_value1000000033[i].set(p, static_mint<1000000033>(_base[i]).pow(p)*x);
+			_value998244353[i].set(p, _pow998244353[i](p)*x);
+			_value1000000007[i].set(p, _pow1000000007[i](p)*x);
+			_value1000000009[i].set(p, _pow1000000009[i](p)*x);
+			_value1000000021[i].set(p, _pow1000000021[i](p)*x);
+			_value1000000033[i].set(p, _pow1000000033[i](p)*x);
 		}
 	}
 	array<tuple<static_mint<998244353>, static_mint<1000000007>, static_mint<1000000009>, static_mint<1000000021>, static_mint<1000000033>>, base_size> get(int l, int r) {
 		array<tuple<static_mint<998244353>, static_mint<1000000007>, static_mint<1000000009>, static_mint<1000000021>, static_mint<1000000033>>, base_size> res;
 		for (int i = 0; i < base_size; i++) {
 			res[i] = {
-				_value998244353[i].sum(l, r)*static_mint<998244353>(_base[i]).pow(-l),
-				_value1000000007[i].sum(l, r)*static_mint<1000000007>(_base[i]).pow(-l),
-				_value1000000009[i].sum(l, r)*static_mint<1000000009>(_base[i]).pow(-l),
-				_value1000000021[i].sum(l, r)*static_mint<1000000021>(_base[i]).pow(-l),
-				_value1000000033[i].sum(l, r)*static_mint<1000000033>(_base[i]).pow(-l),
+				_value998244353[i].sum(l, r)*_pow998244353[i](-l),
+				_value1000000007[i].sum(l, r)*_pow1000000007[i](-l),
+				_value1000000009[i].sum(l, r)*_pow1000000009[i](-l),
+				_value1000000021[i].sum(l, r)*_pow1000000021[i](-l),
+				_value1000000033[i].sum(l, r)*_pow1000000033[i](-l),
 			};
 		}
 		return res;
 	}
 private:
 	array<fenwick_tree<static_mint<998244353>>, base_size> _value998244353;
+	array<fixed_base_pow<static_mint<998244353>>, base_size> _pow998244353;
 	array<fenwick_tree<static_mint<1000000007>>, base_size> _value1000000007;
+	array<fixed_base_pow<static_mint<1000000007>>, base_size> _pow1000000007;
 	array<fenwick_tree<static_mint<1000000009>>, base_size> _value1000000009;
+	array<fixed_base_pow<static_mint<1000000009>>, base_size> _pow1000000009;
 	array<fenwick_tree<static_mint<1000000021>>, base_size> _value1000000021;
+	array<fixed_base_pow<static_mint<1000000021>>, base_size> _pow1000000021;
 	array<fenwick_tree<static_mint<1000000033>>, base_size> _value1000000033;
+	array<fixed_base_pow<static_mint<1000000033>>, base_size> _pow1000000033;
 	array<int, base_size> _base;
 	int _n;
 	void _init_base() {
 		_base = generate_base();
 	}
 	template<int mod>
-	void _init_value(int n, array<fenwick_tree<static_mint<mod>>, base_size> &value) {
-		for (int i = 0; i < base_size; i++) value[i] = fenwick_tree<static_mint<mod>>(n);
+	void _init_value(int n, array<fenwick_tree<static_mint<mod>>, base_size> &value, array<fixed_base_pow<static_mint<mod>>, base_size> &pw) {
+		for (int i = 0; i < base_size; i++) {
+			value[i] = fenwick_tree<static_mint<mod>>(n);
+			pw[i] = fixed_base_pow<static_mint<mod>>(_base[i], max(n-1, 0), -n);
+		}
 	}
 	template<int mod>
-	void _init_value(vector<T> &v, array<fenwick_tree<static_mint<mod>>, base_size> &value) {
-		_init_value(v.size(), value);
+	void _init_value(vector<T> &v, array<fenwick_tree<static_mint<mod>>, base_size> &value, array<fixed_base_pow<static_mint<mod>>, base_size> &pw) {
+		_init_value<mod>(v.size(), value, pw);
 		for (int i = 0; i < base_size; i++) {
 			static_mint<mod> p = 1;
 			for (int j = 0; j < v.size(); j++) {
@@ -87,18 +97,18 @@ private:
 	}
 	void _init_data(int n) {
 		_n = n;
-		_init_value<998244353>(_n, _value998244353);
-		_init_value<1000000007>(_n, _value1000000007);
-		_init_value<1000000009>(_n, _value1000000009);
-		_init_value<1000000021>(_n, _value1000000021);
-		_init_value<1000000033>(_n, _value1000000033);
+		_init_value<998244353>(_n, _value998244353, _pow998244353);
+		_init_value<1000000007>(_n, _value1000000007, _pow1000000007);
+		_init_value<1000000009>(_n, _value1000000009, _pow1000000009);
+		_init_value<1000000021>(_n, _value1000000021, _pow1000000021);
+		_init_value<1000000033>(_n, _value1000000033, _pow1000000033);
 	}
 	void _init_data(vector<T> &v) {
 		_n = v.size();
-		_init_value<998244353>(v, _value998244353);
-		_init_value<1000000007>(v, _value1000000007);
-		_init_value<1000000009>(v, _value1000000009);
-		_init_value<1000000021>(v, _value1000000021);
-		_init_value<1000000033>(v, _value1000000033);
+		_init_value<998244353>(v, _value998244353, _pow998244353);
+		_init_value<1000000007>(v, _value1000000007, _pow1000000007);
+		_init_value<1000000009>(v, _value1000000009, _pow1000000009);
+		_init_value<1000000021>(v, _value1000000021, _pow1000000021);
+		_init_value<1000000033>(v, _value1000000033, _pow1000000033);
 	}
 };
\ No newline at end of file